@@ -0,0 +1,231 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MotorMotionBench.cpp
+ * @brief 
+ *      Microbenchmarks of the MotorMotion hot path, run against the 
+ *      simulation HAL.
+ * 
+ * Each operation is called on every motor of a group, for groups of 1 to 62
+ * motors, and the latency of every call is recorded. The p50/p99 latencies
+ * and the throughput of each operation are printed, and also written to a
+ * JSON report so results can be compared between releases.
+ * 
+ * Usage: MotorMotionBench [report path (motormotion-bench.json)] [iterations (1000)]
+ */
+
+#include <hal/HALBase.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "laser/TalonFXMotion.h"
+#include "laser/MotorMotionCommand.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Highest valid TalonFX device ID, and so the largest group of distinct motors */
+    constexpr int maxDeviceID = 62;
+
+    /** @brief Sizes of the motor groups to measure */
+    constexpr int groupSizes[] = { 1, 2, 4, 8, 16, 32, maxDeviceID };
+
+    /** @brief Iterations run before measuring, so caches and the vendor library are warm */
+    constexpr int warmupIterations = 100;
+
+    /**
+     * @brief 
+     *      Measured latency and throughput of one operation on one group size
+     */
+    struct Result {
+        std::string operation;
+        int motors;
+        long samples;
+        double p50Ns;
+        double p99Ns;
+        double callsPerSecond;
+    };
+
+    /**
+     * @brief 
+     *      Returns a percentile of sorted latency samples
+     */
+    double Percentile(const std::vector<double>& sorted, double fraction) {
+        size_t index = std::min(sorted.size() - 1, (size_t)(fraction * sorted.size()));
+        return sorted[index];
+    }
+
+    /**
+     * @brief 
+     *      Times every call of an operation, across every motor of the group,
+     *      for the given number of iterations
+     * @param op
+     *      Called with the index of the motor and the iteration number
+     */
+    Result Measure(const std::string& operation, int motors, int iterations, const std::function<void(int, int)>& op) {
+        for (int i = 0; i < warmupIterations; i++) {
+            for (int m = 0; m < motors; m++) {
+                op(m, i);
+            }
+        }
+
+        std::vector<double> samples;
+        samples.reserve((size_t)iterations * motors);
+
+        Clock::time_point begin = Clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (int m = 0; m < motors; m++) {
+                Clock::time_point start = Clock::now();
+                op(m, i);
+                Clock::time_point end = Clock::now();
+
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.operation = operation;
+        result.motors = motors;
+        result.samples = (long)samples.size();
+        result.p50Ns = Percentile(samples, 0.50);
+        result.p99Ns = Percentile(samples, 0.99);
+        result.callsPerSecond = samples.size() / elapsed;
+        return result;
+    }
+
+    /**
+     * @brief 
+     *      Writes the results as JSON
+     */
+    bool WriteReport(const std::string& path, int iterations, const std::vector<Result>& results) {
+        std::ofstream report(path);
+        if (!report) {
+            return false;
+        }
+
+        report << "{\n";
+        report << "  \"benchmark\": \"MotorMotion\",\n";
+        report << "  \"iterations\": " << iterations << ",\n";
+        report << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& result = results[i];
+            report << "    { \"operation\": \"" << result.operation << "\""
+                   << ", \"motors\": " << result.motors
+                   << ", \"samples\": " << result.samples
+                   << ", \"p50_ns\": " << result.p50Ns
+                   << ", \"p99_ns\": " << result.p99Ns
+                   << ", \"calls_per_second\": " << result.callsPerSecond
+                   << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        report << "  ]\n";
+        report << "}\n";
+
+        return (bool)report;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string reportPath = (argc > 1) ? argv[1] : "motormotion-bench.json";
+    int iterations = (argc > 2) ? std::atoi(argv[2]) : 1000;
+    if (iterations <= 0) {
+        std::fprintf(stderr, "Iterations must be positive\n");
+        return 1;
+    }
+
+    if (!HAL_Initialize(500, 0)) {
+        std::fprintf(stderr, "Failed to initialize the HAL\n");
+        return 1;
+    }
+
+    std::vector<Result> results;
+
+    for (int motors : groupSizes) {
+        std::vector<std::unique_ptr<talonfx::TalonFXMotion>> group;
+        std::vector<std::unique_ptr<commands::TalonFXMotionCommand>> groupCommands;
+        for (int m = 0; m < motors; m++) {
+            group.push_back(std::make_unique<talonfx::TalonFXMotion>(m + 1, 10.0, 0.1_m));
+            group.back()->SetPIDValues(ePosition, 0.1, 0.0, 0.0, 0.05);
+            groupCommands.push_back(std::make_unique<commands::TalonFXMotionCommand>(group.back().get(), commands::eManualForward));
+            groupCommands.back()->Initialize();
+        }
+
+        results.push_back(Measure("SetSetpoint", motors, iterations, [&](int m, int i) {
+            group[m]->SetSetpoint(units::meter_t((i % 2) ? 1.0 : 2.0));
+        }));
+
+        // Most reads are served from the cached state; p99 includes the 
+        // periodic refresh
+        results.push_back(Measure("GetActualPosition", motors, iterations, [&](int m, int) {
+            volatile double position = (double)group[m]->GetActualPosition();
+            (void)position;
+        }));
+        results.push_back(Measure("GetActualVelocity", motors, iterations, [&](int m, int) {
+            volatile double velocity = (double)group[m]->GetActualVelocity();
+            (void)velocity;
+        }));
+        results.push_back(Measure("IsFwdLimitSwitchPressed", motors, iterations, [&](int m, int) {
+            volatile bool isPressed = group[m]->IsFwdLimitSwitchPressed();
+            (void)isPressed;
+        }));
+
+        // Alternating gains so every call is sent, and repeated gains so 
+        // every call is suppressed by the config cache
+        results.push_back(Measure("SetPIDValues", motors, iterations, [&](int m, int i) {
+            group[m]->SetPIDValues(ePosition, (i % 2) ? 0.1 : 0.2, 0.0, 0.0, 0.05);
+        }));
+        results.push_back(Measure("SetPIDValuesUnchanged", motors, iterations, [&](int m, int) {
+            group[m]->SetPIDValues(ePosition, 0.1, 0.0, 0.0, 0.05);
+        }));
+
+        results.push_back(Measure("MotorMotionCommand::Execute", motors, iterations, [&](int m, int) {
+            groupCommands[m]->Execute();
+        }));
+
+        for (auto& command : groupCommands) {
+            command->End(true);
+        }
+    }
+
+    std::printf("%-28s %7s %12s %12s %14s\n", "operation", "motors", "p50 (ns)", "p99 (ns)", "calls/s");
+    for (const Result& result : results) {
+        std::printf("%-28s %7d %12.0f %12.0f %14.0f\n", result.operation.c_str(), result.motors, result.p50Ns, result.p99Ns, result.callsPerSecond);
+    }
+
+    if (!WriteReport(reportPath, iterations, results)) {
+        std::fprintf(stderr, "Failed to write %s\n", reportPath.c_str());
+        return 1;
+    }
+    std::printf("Report written to %s\n", reportPath.c_str());
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/AbsoluteSensor.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+std::function<std::optional<units::turn_t>()> sensors::FromCANCoder(ctre::phoenix::sensors::CANCoder* cancoder) {
+    return [cancoder]() -> std::optional<units::turn_t> {
+        double degrees = cancoder->GetAbsolutePosition();
+
+        // No status frame has been received yet
+        if (cancoder->GetLastError() != ctre::phoenix::ErrorCode::OK) {
+            return std::nullopt;
+        }
+
+        ctre::phoenix::sensors::MagnetFieldStrength strength = cancoder->GetMagnetFieldStrength();
+        if (strength == ctre::phoenix::sensors::MagnetFieldStrength::Invalid_Unknown
+            || strength == ctre::phoenix::sensors::MagnetFieldStrength::BadRange_RedLED) {
+            return std::nullopt;
+        }
+
+        return units::turn_t(units::degree_t(degrees));
+    };
+}
+
+std::function<std::optional<units::turn_t>()> sensors::FromDutyCycle(frc::DutyCycleEncoder* encoder) {
+    // Already in [0, 1) rotations
+    return [encoder]() -> std::optional<units::turn_t> {
+        if (!encoder->IsConnected()) {
+            return std::nullopt;
+        }
+
+        return units::turn_t(encoder->GetAbsolutePosition());
+    };
+}
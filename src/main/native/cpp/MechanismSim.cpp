@@ -0,0 +1,135 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/MechanismSim.h"
+
+using namespace laser::simulation;
+////////////////////////////////////////////////////////////////////////////////
+
+FlywheelMechanism::FlywheelMechanism(const frc::DCMotor& gearbox, double gearing, units::kilogram_square_meter_t moi) :
+    plant(gearbox, gearing, moi)
+{}
+
+void FlywheelMechanism::SetInputVoltage(units::volt_t voltage) {
+    plant.SetInputVoltage(voltage);
+}
+
+void FlywheelMechanism::Update(units::second_t dt) {
+    plant.Update(dt);
+    angle += plant.GetAngularVelocity() * dt;
+}
+
+units::radian_t FlywheelMechanism::GetAngle() {
+    return angle;
+}
+
+units::radians_per_second_t FlywheelMechanism::GetAngularVelocity() {
+    return plant.GetAngularVelocity();
+}
+
+units::ampere_t FlywheelMechanism::GetCurrentDraw() {
+    return plant.GetCurrentDraw();
+}
+
+ElevatorMechanism::ElevatorMechanism(
+    const frc::DCMotor& gearbox,
+    double gearing,
+    units::kilogram_t carriageMass,
+    units::meter_t radius,
+    units::meter_t lowest,
+    units::meter_t highest,
+    bool simulateGravity
+) :
+    plant(gearbox, gearing, carriageMass, radius, lowest, highest, simulateGravity),
+    drumRadius(radius),
+    minHeight(lowest),
+    maxHeight(highest)
+{}
+
+void ElevatorMechanism::SetInputVoltage(units::volt_t voltage) {
+    plant.SetInputVoltage(voltage);
+}
+
+void ElevatorMechanism::Update(units::second_t dt) {
+    plant.Update(dt);
+}
+
+units::radian_t ElevatorMechanism::GetAngle() {
+    // arc length / radius
+    return units::radian_t((double)(plant.GetPosition() / drumRadius));
+}
+
+units::radians_per_second_t ElevatorMechanism::GetAngularVelocity() {
+    return units::radians_per_second_t((double)plant.GetVelocity() / (double)drumRadius);
+}
+
+units::ampere_t ElevatorMechanism::GetCurrentDraw() {
+    return plant.GetCurrentDraw();
+}
+
+bool ElevatorMechanism::IsAtLowerLimit() {
+    // The plant clamps the carriage onto the limit itself, where its own 
+    // HasHitLowerLimit() no longer holds
+    return plant.GetPosition() <= minHeight;
+}
+
+bool ElevatorMechanism::IsAtUpperLimit() {
+    return plant.GetPosition() >= maxHeight;
+}
+
+ArmMechanism::ArmMechanism(
+    const frc::DCMotor& gearbox,
+    double gearing,
+    units::kilogram_square_meter_t moi,
+    units::meter_t armLength,
+    units::radian_t lowest,
+    units::radian_t highest,
+    bool simulateGravity
+) :
+    plant(gearbox, gearing, moi, armLength, lowest, highest, simulateGravity),
+    minAngle(lowest),
+    maxAngle(highest)
+{}
+
+void ArmMechanism::SetInputVoltage(units::volt_t voltage) {
+    plant.SetInputVoltage(voltage);
+}
+
+void ArmMechanism::Update(units::second_t dt) {
+    plant.Update(dt);
+}
+
+units::radian_t ArmMechanism::GetAngle() {
+    return plant.GetAngle();
+}
+
+units::radians_per_second_t ArmMechanism::GetAngularVelocity() {
+    return plant.GetVelocity();
+}
+
+units::ampere_t ArmMechanism::GetCurrentDraw() {
+    return plant.GetCurrentDraw();
+}
+
+bool ArmMechanism::IsAtLowerLimit() {
+    return plant.GetAngle() <= minAngle;
+}
+
+bool ArmMechanism::IsAtUpperLimit() {
+    return plant.GetAngle() >= maxAngle;
+}
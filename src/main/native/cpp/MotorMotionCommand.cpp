@@ -29,6 +29,7 @@ MotorMotionCommand<ErrorEnum, MotorType>::MotorMotionCommand(MotorMotion<ErrorEn
     maxHomeTime = timeout;
     revHomeSpeed = speed;
     fwdHomeSpeed = -speed;
+    slowHomeSpeed = speed / 5.0;
 }
 
 template <class ErrorEnum, class MotorType>
@@ -42,6 +43,14 @@ template <class ErrorEnum, class MotorType>
 void MotorMotionCommand<ErrorEnum, MotorType>::Initialize() {
     timer->Start();
     startTime = timer->Get();
+    stalledCycles = 0;
+
+    // Let the motor controller take the zero of two phase homing itself when
+    // it can, so it doesn't depend on the loop period; the fast approach may
+    // clear the position too, but the slow re-approach clears it last
+    if (currentState == eHomeReverseTwoPhase) {
+        isHardwareZero = (motion->SetClearPositionOnRevLimit(true) == ErrorEnum{});
+    }
 }
 
 template <class ErrorEnum, class MotorType>
@@ -112,6 +121,83 @@ void MotorMotionCommand<ErrorEnum, MotorType>::Execute() {
             }
             break;
 
+        case eHomeReverseTwoPhase:
+        case eHomeBackOff:
+        case eHomeReverseSlow:
+            // Give up the same way single phase homing does once the timeout
+            // is reached, regardless of the phase.
+            if ((maxHomeTime > 0.0_s) && (timer->Get() > (startTime + maxHomeTime))) {
+                ReleaseHardwareZero();
+                motion->Reset();
+                currentState = eIdle;
+                break;
+            }
+
+            if (currentState == eHomeReverseTwoPhase) {
+                // Fast approach; the zero isn't taken here, so overshooting 
+                // the switch is fine.
+                if (motion->IsRevLimitSwitchPressed()) {
+                    currentState = eHomeBackOff;
+                } else {
+                    motion->Set(revHomeSpeed);
+                }
+            }
+
+            if (currentState == eHomeBackOff) {
+                // Slowly move off of the switch until it releases.
+                if (!motion->IsRevLimitSwitchPressed()) {
+                    currentState = eHomeReverseSlow;
+                } else {
+                    motion->Set(-slowHomeSpeed);
+                }
+            }
+
+            if (currentState == eHomeReverseSlow) {
+                // Slow approach; without the motor controller's own zero, it
+                // is latched on the first cycle that sees the switch pressed.
+                if (motion->IsRevLimitSwitchPressed()) {
+                    if (isHardwareZero) {
+                        // The controller zeroed the encoder itself, so the 
+                        // cached position is from before the zero
+                        motion->Stop();
+                        ReleaseHardwareZero();
+                        motion->InvalidateState();
+                    } else {
+                        motion->Reset();
+                    }
+                    currentState = eIdle;
+                } else {
+                    motion->Set(slowHomeSpeed);
+                }
+            }
+            break;
+
+        case eHomeReverseStall:
+            // The timeout is only a backstop here; a stall normally ends 
+            // homing as soon as the hard stop is hit.
+            if ((maxHomeTime > 0.0_s) && (timer->Get() > (startTime + maxHomeTime))) {
+                motion->Reset();
+                currentState = eIdle;
+                break;
+            }
+
+            if (timer->Get() > (startTime + stallBlankingTime)
+                && units::math::abs(motion->GetMotorCurrent()) >= stallCurrent
+                && units::math::abs(motion->GetActualVelocity()) <= stallVelocity) {
+                stalledCycles++;
+            } else {
+                stalledCycles = 0;
+            }
+
+            if (stalledCycles >= stallCycles) {
+                // Against the hard stop; stop pushing and zero the encoder
+                motion->Reset();
+                currentState = eIdle;
+            } else {
+                motion->Set(revHomeSpeed);
+            }
+            break;
+
         default:
             currentState = eIdle;
             break;
@@ -119,12 +205,44 @@ void MotorMotionCommand<ErrorEnum, MotorType>::Execute() {
 }
 template <class ErrorEnum, class MotorType>
 void MotorMotionCommand<ErrorEnum, MotorType>::End(bool interrupted) {
+    ReleaseHardwareZero();
     if (interrupted)
         motion->Set(0);
     return;
 }
 
+template <class ErrorEnum, class MotorType>
+void MotorMotionCommand<ErrorEnum, MotorType>::ReleaseHardwareZero() {
+    if (isHardwareZero) {
+        motion->SetClearPositionOnRevLimit(false);
+        isHardwareZero = false;
+    }
+}
+
 template <class ErrorEnum, class MotorType>
 bool MotorMotionCommand<ErrorEnum, MotorType>::IsFinished() {
     return isFinished;
-}
\ No newline at end of file
+}
+
+template <class ErrorEnum, class MotorType>
+void MotorMotionCommand<ErrorEnum, MotorType>::SetSlowHomeSpeed(double speed) {
+    slowHomeSpeed = speed;
+}
+
+template <class ErrorEnum, class MotorType>
+void MotorMotionCommand<ErrorEnum, MotorType>::SetStallDetection(
+    units::ampere_t current, 
+    units::meters_per_second_t velocity, 
+    int cycles, 
+    units::second_t blanking
+) {
+    stallCurrent = current;
+    stallVelocity = velocity;
+    stallCycles = cycles;
+    stallBlankingTime = blanking;
+}
+
+// The template is defined in this file, so each supported motor controller 
+// is instantiated here for users of the library
+template class laser::commands::MotorMotionCommand<ctre::phoenix::ErrorCode, ctre::phoenix::motorcontrol::can::WPI_TalonFX>;
+template class laser::commands::MotorMotionCommand<rev::REVLibError, rev::CANSparkMax>;
\ No newline at end of file
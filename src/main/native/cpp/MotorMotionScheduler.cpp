@@ -0,0 +1,114 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/MotorMotionScheduler.h"
+
+#include <frc/Threads.h>
+#include <frc/Timer.h>
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+MotorMotionScheduler::MotorMotionScheduler(units::second_t cyclePeriod, int priority) :
+    period(cyclePeriod),
+    threadPriority(priority),
+    notifier([this] { Cycle(); })
+{}
+
+MotorMotionScheduler::~MotorMotionScheduler() {
+    notifier.Stop();
+}
+
+void MotorMotionScheduler::AddControlLoop(std::function<void()> loop) {
+    std::lock_guard<std::mutex> lock(mutex);
+    controlLoops.push_back(std::move(loop));
+}
+
+void MotorMotionScheduler::Start() {
+    notifier.StartPeriodic(period.load());
+}
+
+void MotorMotionScheduler::Stop() {
+    notifier.Stop();
+}
+
+void MotorMotionScheduler::SetPeriod(units::second_t cyclePeriod) {
+    period = cyclePeriod;
+}
+
+units::second_t MotorMotionScheduler::GetPeriod() {
+    return period.load();
+}
+
+SchedulerTiming MotorMotionScheduler::GetTiming() {
+    std::lock_guard<std::mutex> lock(timingMutex);
+    return timing;
+}
+
+void MotorMotionScheduler::ResetTiming() {
+    std::lock_guard<std::mutex> lock(timingMutex);
+    timing = SchedulerTiming();
+    lastCycleStart = 0.0_s;
+}
+
+void MotorMotionScheduler::Cycle() {
+    // The priority belongs to the notifier's own thread, which only exists 
+    // once it runs, so it is set from inside the first cycle; the HAL-wide 
+    // notifier priority would only raise the alarm thread
+    if (!isPriorityApplied) {
+        if (threadPriority > 0) {
+            frc::SetCurrentThreadPriority(true, threadPriority);
+        }
+        isPriorityApplied = true;
+    }
+
+    units::second_t start = frc::Timer::GetFPGATimestamp();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Read every motor once, then let the control loops compute and write
+        for (auto& refresh : refreshes) {
+            refresh();
+        }
+        for (auto& loop : controlLoops) {
+            loop();
+        }
+    }
+
+    units::second_t end = frc::Timer::GetFPGATimestamp();
+
+    std::lock_guard<std::mutex> lock(timingMutex);
+
+    timing.cycles++;
+    timing.lastCycleTime = end - start;
+    if (timing.lastCycleTime > timing.maxCycleTime) {
+        timing.maxCycleTime = timing.lastCycleTime;
+    }
+    if (timing.lastCycleTime > period.load()) {
+        timing.overruns++;
+    }
+
+    if (lastCycleStart > 0.0_s) {
+        timing.lastLoopPeriod = start - lastCycleStart;
+        if (timing.lastLoopPeriod > timing.maxLoopPeriod) {
+            timing.maxLoopPeriod = timing.lastLoopPeriod;
+        }
+    }
+    lastCycleStart = start;
+}
@@ -0,0 +1,120 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/SimulationHarness.h"
+
+#include <frc/simulation/DriverStationSim.h>
+#include <frc/simulation/SimHooks.h>
+#include <ctre/phoenix/unmanaged/Unmanaged.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace laser::simulation;
+////////////////////////////////////////////////////////////////////////////////
+
+SimulationHarness::SimulationHarness(units::second_t fixedStep) :
+    step(fixedStep)
+{
+    frc::sim::PauseTiming();
+    SetEnabled(true);
+}
+
+SimulationHarness::~SimulationHarness() {
+    SetEnabled(false);
+    frc::sim::ResumeTiming();
+}
+
+void SimulationHarness::AddControlLoop(std::function<void()> loop) {
+    controlLoops.push_back(std::move(loop));
+}
+
+void SimulationHarness::Schedule(frc2::Command* command) {
+    commands.push_back({ command, false });
+}
+
+bool SimulationHarness::IsScheduled(frc2::Command* command) {
+    return std::any_of(commands.begin(), commands.end(), [command](const ScheduledCommand& scheduled) {
+        return scheduled.command == command;
+    });
+}
+
+void SimulationHarness::Step() {
+    // The simulated motor controllers disable themselves without a recent 
+    // enable signal
+    ctre::phoenix::unmanaged::Unmanaged::FeedEnable(100);
+
+    for (auto& loop : controlLoops) {
+        loop();
+    }
+
+    // Commands run in the order they were scheduled, like the command 
+    // scheduler; finished commands are removed
+    for (auto it = commands.begin(); it != commands.end();) {
+        if (!it->isInitialized) {
+            it->command->Initialize();
+            it->isInitialized = true;
+        }
+
+        it->command->Execute();
+
+        if (it->command->IsFinished()) {
+            it->command->End(false);
+            it = commands.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    frc::sim::StepTiming(step);
+    steps++;
+
+    for (auto& simulationPeriodic : motors) {
+        simulationPeriodic(step);
+    }
+}
+
+void SimulationHarness::Run(units::second_t duration) {
+    long count = (long)std::llround((double)(duration / step));
+    for (long i = 0; i < count; i++) {
+        Step();
+    }
+}
+
+bool SimulationHarness::RunUntil(std::function<bool()> condition, units::second_t timeout) {
+    long count = (long)std::llround((double)(timeout / step));
+    for (long i = 0; i < count; i++) {
+        Step();
+        if (condition()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SimulationHarness::SetEnabled(bool isEnabled) {
+    frc::sim::DriverStationSim::SetEnabled(isEnabled);
+    frc::sim::DriverStationSim::NotifyNewData();
+}
+
+units::second_t SimulationHarness::GetTime() {
+    return step * (double)steps;
+}
+
+units::second_t SimulationHarness::GetStep() {
+    return step;
+}
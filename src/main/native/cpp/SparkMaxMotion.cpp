@@ -0,0 +1,621 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/SparkMaxMotion.h"
+
+#include <frc/RobotController.h>
+#include <frc/simulation/SimDeviceSim.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace laser::sparkmax;
+////////////////////////////////////////////////////////////////////////////////
+
+SparkMaxMotion::SparkMaxMotion(int devID, double ratio, units::meter_t diameter) {
+    deviceID = devID;
+    gearing = ratio;
+    wheelDiameter = diameter;
+    motor = new rev::CANSparkMax(deviceID, rev::CANSparkMax::MotorType::kBrushless);
+    encoder = new rev::SparkMaxRelativeEncoder(motor->GetEncoder());
+    pidController = new rev::SparkMaxPIDController(motor->GetPIDController());
+
+    // A setpoint must be specified before one can be used within the class
+    setpointType = eNone;
+
+    // Limit switches are Normally Open until configured otherwise
+    isFwdLimitSwitchNO = true;
+    isRevLimitSwitchNO = true;
+    fwdLimitSwitch = new rev::SparkMaxLimitSwitch(motor->GetForwardLimitSwitch(rev::SparkMaxLimitSwitch::Type::kNormallyOpen));
+    revLimitSwitch = new rev::SparkMaxLimitSwitch(motor->GetReverseLimitSwitch(rev::SparkMaxLimitSwitch::Type::kNormallyOpen));
+
+    // Nothing is configured on the controller until it is set
+    positionTolerance = 0.0_m;
+    velocityTolerance = 0.0_mps;
+    avelTolerance = units::radians_per_second_t(0.0);
+    izone = 0.0;
+    maxProfileVelocity = 0.0_mps;
+    maxProfileAcceleration = units::meters_per_second_squared_t(0.0);
+    profileSCurveStrength = 0;
+
+    // Every status frame starts at its factory default rate, and new 
+    // feedback can't arrive faster than the feedback frames
+    for (const defaults::StatusFrameDefault& status : defaults::statusFrames) {
+        statusFramePeriods[(int)status.frame] = status.period;
+    }
+    stateMaxAge = std::min(
+        statusFramePeriods[(int)rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus1],
+        statusFramePeriods[(int)rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus2]
+    );
+
+    UpdateConversionFactors();
+
+    // Reset the motor
+    Reset();
+}
+
+SparkMaxMotion::~SparkMaxMotion() {
+    // Queued configuration writes still reference the motor
+    WaitForConfig();
+
+    delete fwdLimitSwitch;
+    delete revLimitSwitch;
+    delete pidController;
+    delete encoder;
+    delete motor;
+
+    fwdLimitSwitch = nullptr;
+    revLimitSwitch = nullptr;
+    pidController = nullptr;
+    encoder = nullptr;
+    motor = nullptr;
+}
+
+void SparkMaxMotion::SetSetpoint(units::meter_t position) {
+    positionSetpoint = position;
+
+    // The encoder reports in meters, so no conversion is needed
+    pidController->SetReference(
+        (double)positionSetpoint * nativePerMeter,
+        rev::CANSparkMax::ControlType::kPosition,
+        defaults::positionSlot,
+        CalculateFeedforward(positionSetpoint, 0.0_mps).value(),
+        rev::SparkMaxPIDController::ArbFFUnits::kVoltage
+    );
+
+    setpointType = ePosition;
+    PublishSetpoint();
+}
+
+void SparkMaxMotion::SetSetpoint(units::meters_per_second_t lvelocity) {
+    velocitySetpoint = ClampVelocity(lvelocity);
+
+    pidController->SetReference(
+        (double)velocitySetpoint * nativePerMps,
+        rev::CANSparkMax::ControlType::kVelocity,
+        defaults::linearVelocitySlot,
+        CalculateFeedforward(velocitySetpoint).value(),
+        rev::SparkMaxPIDController::ArbFFUnits::kVoltage
+    );
+
+    setpointType = eLinearVelocity;
+    PublishSetpoint();
+}
+
+void SparkMaxMotion::SetSetpoint(units::radians_per_second_t avelocity) {
+    avelSetpoint = ClampVelocity(avelocity);
+
+    // rad/s of the output shaft -> m/s at the wheel
+    pidController->SetReference(
+        (double)avelSetpoint * nativePerRadPerSec,
+        rev::CANSparkMax::ControlType::kVelocity,
+        defaults::angularVelocitySlot,
+        CalculateFeedforward(units::meters_per_second_t((double)avelSetpoint * nativePerRadPerSec)).value(),
+        rev::SparkMaxPIDController::ArbFFUnits::kVoltage
+    );
+
+    setpointType = eAngularVelocity;
+    PublishSetpoint();
+}
+
+void SparkMaxMotion::SetSetpoint(units::radian_t angle) {
+    apositionSetpoint = GetNearestAngle(angle);
+
+    // radians of the output shaft -> meters at the wheel; angles share the 
+    // position slot
+    pidController->SetReference(
+        (double)apositionSetpoint * nativePerRadian,
+        rev::CANSparkMax::ControlType::kPosition,
+        defaults::positionSlot,
+        CalculateFeedforward(units::meter_t((double)apositionSetpoint * nativePerRadian), 0.0_mps).value(),
+        rev::SparkMaxPIDController::ArbFFUnits::kVoltage
+    );
+
+    setpointType = eAngularPosition;
+    PublishSetpoint();
+}
+
+void SparkMaxMotion::SetProfiledSetpoint(units::meter_t position) {
+    positionSetpoint = position;
+
+    // Control through Smart Motion; the controller generates the profile, so
+    // the feedforward is only known at the target, where it holds the 
+    // mechanism against gravity once the profile ends
+    pidController->SetReference(
+        (double)positionSetpoint * nativePerMeter,
+        rev::CANSparkMax::ControlType::kSmartMotion,
+        defaults::profiledPositionSlot,
+        CalculateFeedforward(positionSetpoint, 0.0_mps).value(),
+        rev::SparkMaxPIDController::ArbFFUnits::kVoltage
+    );
+
+    setpointType = eProfiledPosition;
+    PublishSetpoint();
+}
+
+rev::REVLibError SparkMaxMotion::SetClearPositionOnRevLimit(bool isEnabled) {
+    lastError = rev::REVLibError::kNotImplemented;
+    return rev::REVLibError::kNotImplemented;
+}
+
+rev::REVLibError SparkMaxMotion::StartTrajectory(std::span<const TrajectoryPoint> points) {
+    lastError = rev::REVLibError::kNotImplemented;
+    return rev::REVLibError::kNotImplemented;
+}
+
+laser::TrajectoryProgress SparkMaxMotion::GetTrajectoryProgress() {
+    return TrajectoryProgress();
+}
+
+void SparkMaxMotion::SetMotionConstraints(
+    units::meters_per_second_t maxVelocity, 
+    units::meters_per_second_squared_t maxAcceleration, 
+    int sCurveStrength
+) {
+    // Set the member variables; Smart Motion profiles are always trapezoidal
+    maxProfileVelocity = maxVelocity;
+    maxProfileAcceleration = maxAcceleration;
+    profileSCurveStrength = 0;
+
+    // Smart Motion works in the converted units, m/s and m/s^2
+    double velocity = (double)maxProfileVelocity * nativePerMps;
+    double acceleration = (double)maxProfileAcceleration * nativePerMps;
+
+    IssueConfig(eConfigProfileVelocity, defaults::profiledPositionSlot, velocity, [=, this](int) {
+        return pidController->SetSmartMotionMaxVelocity(velocity, defaults::profiledPositionSlot);
+    });
+    IssueConfig(eConfigProfileAcceleration, defaults::profiledPositionSlot, acceleration, [=, this](int) {
+        return pidController->SetSmartMotionMaxAccel(acceleration, defaults::profiledPositionSlot);
+    });
+}
+
+void SparkMaxMotion::SetMotorVoltage(units::volt_t voltage) {
+    motor->SetVoltage(voltage);
+    commandedVoltage = voltage;
+    MarkActive();
+}
+
+void SparkMaxMotion::Stop() {
+    // Stop the motor.
+    motor->Set(0.000);
+    commandedVoltage = 0.0_V;
+    isStopped = true;
+}
+
+void SparkMaxMotion::SetTolerance(units::meter_t tolerance) {
+    // Only Smart Motion has an allowed error on the Spark Max
+    double meters = (double)tolerance * nativePerMeter;
+    IssueConfig(eConfigTolerance, defaults::profiledPositionSlot, meters, [=, this](int) {
+        return pidController->SetSmartMotionAllowedClosedLoopError(meters, defaults::profiledPositionSlot);
+    });
+
+    // Set the member variable.
+    positionTolerance = tolerance;
+}
+
+void SparkMaxMotion::SetTolerance(units::meters_per_second_t tolerance) {
+    // Set the member variable.
+    velocityTolerance = tolerance;
+}
+
+void SparkMaxMotion::SetTolerance(units::radians_per_second_t tolerance) {
+    // Set the member variable.
+    avelTolerance = tolerance;
+}
+
+units::meter_t SparkMaxMotion::GetPositionTolerance() {
+    return positionTolerance;
+}
+
+units::meters_per_second_t SparkMaxMotion::GetVelocityTolerance() {
+    return velocityTolerance;
+}
+
+units::radians_per_second_t SparkMaxMotion::GetAngularVelocityTolerance() {
+    return avelTolerance;
+}
+
+void SparkMaxMotion::SetTolerance(units::radian_t tolerance) {
+    // Set the member variable.
+    apositionTolerance = tolerance;
+}
+
+units::radian_t SparkMaxMotion::GetAngularPositionTolerance() {
+    return apositionTolerance;
+}
+
+void SparkMaxMotion::ConfigLimitSwitches(bool isFwdNO, bool isRevNO) {
+    // The polarity is written when the limit switch object is created, so a
+    // changed polarity means a new object
+    if (isFwdNO != isFwdLimitSwitchNO) {
+        isFwdLimitSwitchNO = isFwdNO;
+        delete fwdLimitSwitch;
+        fwdLimitSwitch = new rev::SparkMaxLimitSwitch(motor->GetForwardLimitSwitch(
+            isFwdLimitSwitchNO ? rev::SparkMaxLimitSwitch::Type::kNormallyOpen : rev::SparkMaxLimitSwitch::Type::kNormallyClosed
+        ));
+    }
+    if (isRevNO != isRevLimitSwitchNO) {
+        isRevLimitSwitchNO = isRevNO;
+        delete revLimitSwitch;
+        revLimitSwitch = new rev::SparkMaxLimitSwitch(motor->GetReverseLimitSwitch(
+            isRevLimitSwitchNO ? rev::SparkMaxLimitSwitch::Type::kNormallyOpen : rev::SparkMaxLimitSwitch::Type::kNormallyClosed
+        ));
+    }
+}
+
+void SparkMaxMotion::SetAccumIZone(double _izone) {
+    // Set the member variable.
+    izone = _izone;
+
+    // Same value as the TalonFX takes, izone / gearing revolutions of the 
+    // motor, converted to meters; the integral zone is global, so every slot
+    // gets the same value
+    double meters = izone / gearing * metersPerMotorRev;
+    for (int slot : { defaults::positionSlot, defaults::linearVelocitySlot, defaults::angularVelocitySlot, defaults::profiledPositionSlot }) {
+        IssueConfig(eConfigIntegralZone, slot, meters, [=, this](int) {
+            return pidController->SetIZone(meters, slot);
+        });
+    }
+}
+
+void SparkMaxMotion::SetPositionSoftLimits(units::meter_t minpos, units::meter_t maxpos) {
+    // Limits given in the wrong order are swapped rather than crossing
+    if (minpos > maxpos) {
+        std::swap(minpos, maxpos);
+    }
+    lowerPositionSoftLimit = minpos;
+    upperPositionSoftLimit = maxpos;
+
+    // Soft limits are in the converted units, meters. A NAN never matches the
+    // shadow configuration, so disabling always writes
+    bool isEnabled = (minpos != maxpos);
+    double forward = (double)maxpos * nativePerMeter;
+    double reverse = (double)minpos * nativePerMeter;
+
+    IssueConfig(eConfigFwdSoftLimit, 0, isEnabled ? forward : NAN, [=, this](int) {
+        rev::REVLibError error = motor->SetSoftLimit(rev::CANSparkMax::SoftLimitDirection::kForward, forward);
+        if (error != rev::REVLibError::kOk) {
+            return error;
+        }
+        return motor->EnableSoftLimit(rev::CANSparkMax::SoftLimitDirection::kForward, isEnabled);
+    });
+    IssueConfig(eConfigRevSoftLimit, 0, isEnabled ? reverse : NAN, [=, this](int) {
+        rev::REVLibError error = motor->SetSoftLimit(rev::CANSparkMax::SoftLimitDirection::kReverse, reverse);
+        if (error != rev::REVLibError::kOk) {
+            return error;
+        }
+        return motor->EnableSoftLimit(rev::CANSparkMax::SoftLimitDirection::kReverse, isEnabled);
+    });
+}
+
+void SparkMaxMotion::Reset() {
+    Stop();
+    // Reset the encoder count to zero, or to the true position when there is
+    // an absolute sensor
+    units::meter_t seed = GetSeedPosition();
+    encoder->SetPosition((double)seed * nativePerMeter);
+    SeedPlant(seed);
+
+    // The cached position is no longer valid
+    InvalidateState();
+}
+
+void SparkMaxMotion::SetClosedRampRate(units::second_t time) {
+    IssueConfig(eConfigClosedRampRate, 0, (double)time, [=, this](int) {
+        return motor->SetClosedLoopRampRate((double)time);
+    });
+}
+
+void SparkMaxMotion::SetOpenRampRate(units::second_t time) {
+    IssueConfig(eConfigOpenRampRate, 0, (double)time, [=, this](int) {
+        return motor->SetOpenLoopRampRate((double)time);
+    });
+}
+
+void SparkMaxMotion::Refresh() {
+    // A stale getter on another thread may refresh at the same time
+    std::unique_lock<std::mutex> lock(refreshMutex);
+
+    // A plant driven mechanism is read in place of the simulated controller
+    PublishMeasurement(IsPlantDriven() ? ReadPlant(defaults::countsPerRev) : ReadSensors());
+    UpdateFrameRates();
+
+    // Listeners may call back into this object, and another thread may be 
+    // waiting to refresh it, so they only run once the mutex is released
+    std::vector<std::function<void()>> fired = CollectEvents();
+    lock.unlock();
+    for (std::function<void()>& callback : fired) {
+        callback();
+    }
+}
+
+laser::MotorState SparkMaxMotion::ReadSensors() {
+    // Status 2
+    double position = encoder->GetPosition();
+    // Status 1
+    double velocity = encoder->GetVelocity();
+
+    // Vendor calls happen outside of the publish lock
+    MotorState sample;
+    sample.position = units::meter_t(position * metersPerNative);
+    sample.velocity = units::meters_per_second_t(velocity * mpsPerNative);
+    sample.angularVelocity = units::radians_per_second_t(velocity * radPerSecPerNative);
+    sample.angularPosition = units::radian_t(position * radiansPerNative);
+    sample.rawEncoderCounts = (int)(position / metersPerMotorRev * defaults::countsPerRev);
+
+    // Status 1 (current, bus voltage) and Status 0 (applied output)
+    sample.current = units::ampere_t(motor->GetOutputCurrent());
+    sample.voltage = units::volt_t(motor->GetAppliedOutput() * motor->GetBusVoltage());
+
+    // Status 0; the limit switch objects already account for the polarity
+    sample.isFwdLimitSwitchPressed = fwdLimitSwitch->Get();
+    sample.isRevLimitSwitchPressed = revLimitSwitch->Get();
+
+    sample.timestamp = frc::Timer::GetFPGATimestamp();
+    return sample;
+}
+
+void SparkMaxMotion::SimulationPeriodic(units::second_t dt) {
+    if (!mechanism) {
+        return;
+    }
+
+    if (IsPlantDriven()) {
+        StepPlant(dt);
+        return;
+    }
+
+    // The applied output is in the direction of positive setpoints
+    units::volt_t busVoltage = frc::RobotController::GetBatteryVoltage();
+    double appliedOutput = motor->GetAppliedOutput();
+    mechanism->SetInputVoltage(appliedOutput * busVoltage);
+    mechanism->Update(dt);
+
+    // REVLib publishes the Spark Max's simulated values as a SimDevice; the 
+    // encoder reads back in the converted units
+    frc::sim::SimDeviceSim device(("SPARK MAX [" + std::to_string(deviceID) + "]").c_str());
+    if (!device) {
+        return;
+    }
+
+    hal::SimDouble position = device.GetDouble("Position");
+    hal::SimDouble velocity = device.GetDouble("Velocity");
+    hal::SimDouble current = device.GetDouble("Motor Current");
+    if (position) {
+        position.Set((double)mechanism->GetAngle() * nativePerRadian);
+    }
+    if (velocity) {
+        velocity.Set((double)mechanism->GetAngularVelocity() * nativePerRadPerSec);
+    }
+    if (current) {
+        current.Set(std::abs((double)mechanism->GetCurrentDraw()));
+    }
+}
+
+rev::REVLibError SparkMaxMotion::Follow(MotorMotion& leader, bool isOpposed) {
+    // A motor following itself would never be driven again
+    if (&leader == this) {
+        lastError = rev::REVLibError::kFollowConfigMismatch;
+        return lastError;
+    }
+
+    commandedVoltage = 0.0_V;
+    return motor->Follow(*leader.GetMotorPointer(), isOpposed);
+}
+
+rev::REVLibError SparkMaxMotion::SetPeriodicFramePeriod(rev::CANSparkMaxLowLevel::PeriodicFrame frame, units::millisecond_t period) {
+    int periodMs = (int)period.value();
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        statusFramePeriods[(int)frame] = units::millisecond_t(periodMs);
+
+        // Refreshing faster than the feedback frames only reads the same values
+        if (stateMaxAge > 0.0_s) {
+            stateMaxAge = std::min(
+                statusFramePeriods[(int)rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus1],
+                statusFramePeriods[(int)rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus2]
+            );
+        }
+    }
+
+    return IssueConfig(eConfigStatusFramePeriod, (int)frame, periodMs, [=, this](int) {
+        return motor->SetPeriodicFramePeriod(frame, periodMs);
+    });
+}
+
+rev::REVLibError SparkMaxMotion::ApplySignalFrames(int signals) {
+    rev::REVLibError result = rev::REVLibError::kOk;
+    for (const defaults::StatusFrameDefault& status : defaults::statusFrames) {
+        bool isConsumed = (status.signals & signals) != 0;
+
+        rev::REVLibError error = SetPeriodicFramePeriod(status.frame, isConsumed ? status.period : defaults::slowFramePeriod);
+        if (result == rev::REVLibError::kOk) {
+            result = error;
+        }
+    }
+
+    return result;
+}
+
+void SparkMaxMotion::SetPIDValues(
+    double proportional,
+    double integral, 
+    double derivative, 
+    double feedforward
+) {
+    // Without an active setpoint type, every slot gets the same PID values
+    if (setpointType == eNone) {
+        SetPIDValues(ePosition, proportional, integral, derivative, feedforward);
+        SetPIDValues(eLinearVelocity, proportional, integral, derivative, feedforward);
+        SetPIDValues(eAngularVelocity, proportional, integral, derivative, feedforward);
+        SetPIDValues(eProfiledPosition, proportional, integral, derivative, feedforward);
+    } else {
+        SetPIDValues(setpointType, proportional, integral, derivative, feedforward);
+    }
+}
+
+void SparkMaxMotion::SetPIDValues(
+    SetpointType type,
+    double proportional,
+    double integral, 
+    double derivative, 
+    double feedforward
+) {
+    // Set PID values for either position or velocity, each in its own slot
+    switch (type) {
+        case eNone:
+            break;
+
+        case ePosition:
+            positionProportional = proportional;
+            positionIntegral = integral;
+            positionDerivative = derivative;
+            positionFeedForward = feedforward;
+
+            ConfigSlot(defaults::positionSlot, positionProportional, positionIntegral, positionDerivative, positionFeedForward);
+
+            break;
+        
+        case eLinearVelocity:
+            velocityProportional = proportional;
+            velocityIntegral = integral;
+            velocityDerivative = derivative;
+            velocityFeedForward = feedforward;
+
+            ConfigSlot(defaults::linearVelocitySlot, velocityProportional, velocityIntegral, velocityDerivative, velocityFeedForward);
+
+            break;
+
+        case eAngularVelocity:
+            avelProportional = proportional;
+            avelIntegral = integral;
+            avelDerivative = derivative;
+            avelFeedForward = feedforward;
+
+            ConfigSlot(defaults::angularVelocitySlot, avelProportional, avelIntegral, avelDerivative, avelFeedForward);
+
+            break;
+
+        case eProfiledPosition:
+            profiledProportional = proportional;
+            profiledIntegral = integral;
+            profiledDerivative = derivative;
+            profiledFeedForward = feedforward;
+
+            ConfigSlot(defaults::profiledPositionSlot, profiledProportional, profiledIntegral, profiledDerivative, profiledFeedForward);
+
+            break;
+
+        default:
+            break;
+    }
+}
+
+void SparkMaxMotion::UpdateConversionFactors() {
+    // meters -> revolutions of output shaft -> revolutions of NEO shaft
+    metersPerMotorRev = (double)wheelDiameter * M_PI / gearing;
+    double positionFactor = metersPerMotorRev;
+    // RPM -> m/s
+    double velocityFactor = metersPerMotorRev / 60.0;
+
+    IssueConfig(eConfigPositionConversion, 0, positionFactor, [=, this](int) {
+        return encoder->SetPositionConversionFactor(positionFactor);
+    });
+    IssueConfig(eConfigVelocityConversion, 0, velocityFactor, [=, this](int) {
+        return encoder->SetVelocityConversionFactor(velocityFactor);
+    });
+
+    // The Spark Max now works in meters and m/s directly
+    nativePerMeter = 1.0;
+    metersPerNative = 1.0;
+    nativePerMps = 1.0;
+    mpsPerNative = 1.0;
+
+    // rad/s of the output shaft -> m/s at the wheel
+    nativePerRadPerSec = (double)wheelDiameter / 2.0;
+    radPerSecPerNative = 1.0 / nativePerRadPerSec;
+
+    // radians of the output shaft -> revolutions of NEO shaft -> meters; the
+    // encoder itself counts meters, so angles need the wheel diameter too
+    nativePerRadian = gearing / (2.0 * M_PI) * metersPerMotorRev;
+    radiansPerNative = 1.0 / nativePerRadian;
+
+    // The integral zone is the only value stored in units that depend on the
+    // gearing and wheel diameter
+    if (izone != 0.0) {
+        SetAccumIZone(izone);
+    }
+}
+
+void SparkMaxMotion::ConfigSlot(
+    int slot,
+    double proportional,
+    double integral, 
+    double derivative, 
+    double feedforward
+) {
+    IssueConfig(eConfigProportional, slot, proportional, [=, this](int) {
+        return pidController->SetP(proportional, slot);
+    });
+    IssueConfig(eConfigIntegral, slot, integral, [=, this](int) {
+        return pidController->SetI(integral, slot);
+    });
+    IssueConfig(eConfigDerivative, slot, derivative, [=, this](int) {
+        return pidController->SetD(derivative, slot);
+    });
+    IssueConfig(eConfigFeedForward, slot, feedforward, [=, this](int) {
+        return pidController->SetFF(feedforward, slot);
+    });
+}
+
+void SparkMaxMotion::SetMotorInverted(bool isInverted) {
+    // Whenever a positive input is sent to the motor controller, the output 
+    // will be reversed/negated
+    motor->SetInverted(isInverted);
+    this->isInverted = isInverted;
+}
+
+rev::REVLibError SparkMaxMotion::ConfigCurrentLimit(units::ampere_t amps) {
+    // The smart current limit can't be turned off, only raised back to the 
+    // default
+    unsigned int limit = (amps == 0_A) ? defaults::defaultCurrentLimit : (unsigned int)(double)amps;
+
+    return IssueConfig(eConfigCurrentLimit, 0, (double)amps, [=, this](int) {
+        return motor->SetSmartCurrentLimit(limit);
+    });
+}
@@ -0,0 +1,92 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "laser/SwerveModuleMotion.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+template <class ErrorEnum, class MotorType>
+SwerveModuleMotion<ErrorEnum, MotorType>::SwerveModuleMotion(
+    std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> driveMotion,
+    std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> steerMotion
+) :
+    drive(std::move(driveMotion)),
+    steer(std::move(steerMotion))
+{
+    // The module can spin freely, so any angle is reached the short way
+    steer->SetContinuousInput(true);
+}
+
+template <class ErrorEnum, class MotorType>
+void SwerveModuleMotion<ErrorEnum, MotorType>::SetDesiredState(const frc::SwerveModuleState& desired) {
+    frc::Rotation2d current(steer->GetActualAngularPosition());
+
+    // Reverse the wheel rather than turning more than a quarter turn
+    frc::SwerveModuleState optimized = frc::SwerveModuleState::Optimize(desired, current);
+
+    // Only the part of the speed along the current heading moves the robot
+    // the right way
+    units::meters_per_second_t speed = optimized.speed * (optimized.angle - current).Cos();
+
+    steer->SetSetpoint(optimized.angle.Radians());
+    drive->SetSetpoint(speed);
+}
+
+template <class ErrorEnum, class MotorType>
+void SwerveModuleMotion<ErrorEnum, MotorType>::Stop() {
+    drive->Stop();
+    steer->Stop();
+}
+
+template <class ErrorEnum, class MotorType>
+void SwerveModuleMotion<ErrorEnum, MotorType>::Refresh() {
+    drive->Refresh();
+    steer->Refresh();
+}
+
+template <class ErrorEnum, class MotorType>
+frc::SwerveModuleState SwerveModuleMotion<ErrorEnum, MotorType>::GetState() {
+    return {
+        drive->GetState().velocity,
+        frc::Rotation2d(steer->GetState().angularPosition)
+    };
+}
+
+template <class ErrorEnum, class MotorType>
+frc::SwerveModulePosition SwerveModuleMotion<ErrorEnum, MotorType>::GetPosition() {
+    return {
+        drive->GetState().position,
+        frc::Rotation2d(steer->GetState().angularPosition)
+    };
+}
+
+template <class ErrorEnum, class MotorType>
+MotorMotion<ErrorEnum, MotorType>* SwerveModuleMotion<ErrorEnum, MotorType>::GetDriveMotor() {
+    return drive.get();
+}
+
+template <class ErrorEnum, class MotorType>
+MotorMotion<ErrorEnum, MotorType>* SwerveModuleMotion<ErrorEnum, MotorType>::GetSteerMotor() {
+    return steer.get();
+}
+
+// The template is defined in this file, so each supported motor controller
+// is instantiated here for users of the library
+template class laser::SwerveModuleMotion<ctre::phoenix::ErrorCode, ctre::phoenix::motorcontrol::can::WPI_TalonFX>;
+template class laser::SwerveModuleMotion<rev::REVLibError, rev::CANSparkMax>;
@@ -18,6 +18,10 @@ with MotorMotion. If not, see <https://www.gnu.org/licenses/>.
 
 #include "laser/TalonFXMotion.h"
 
+#include <frc/RobotController.h>
+#include <algorithm>
+#include <cmath>
+
 using namespace laser::talonfx;
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -26,6 +30,7 @@ TalonFXMotion::TalonFXMotion(int devID, double ratio = 1.0, units::meter_t diame
     gearing = ratio;
     wheelDiameter = diameter;
     motor = new ctre::phoenix::motorcontrol::can::WPI_TalonFX(deviceID);
+    trajectoryStream = new ctre::phoenix::motion::BufferedTrajectoryPointStream();
 
     // A setpoint must be specified before one can be used within the class
     setpointType = eNone;
@@ -34,105 +39,297 @@ TalonFXMotion::TalonFXMotion(int devID, double ratio = 1.0, units::meter_t diame
     isFwdLimitSwitchNO = true;
     isRevLimitSwitchNO = true;
 
+    // Nothing is configured on the controller until it is set
+    positionTolerance = 0.0_m;
+    velocityTolerance = 0.0_mps;
+    avelTolerance = units::radians_per_second_t(0.0);
+    izone = 0.0;
+    maxProfileVelocity = 0.0_mps;
+    maxProfileAcceleration = units::meters_per_second_squared_t(0.0);
+    profileSCurveStrength = 0;
+
+    // Every status frame starts at its factory default rate
+    for (const defaults::StatusFrameDefault& status : defaults::statusFrames) {
+        statusFramePeriods[(int)status.frame] = status.period;
+    }
+
+    UpdateConversionFactors();
+
     // Reset the motor
     Reset();
 }
 
 TalonFXMotion::~TalonFXMotion() {
+    // Queued configuration writes still reference the motor
+    WaitForConfig();
+
     delete motor;
+    delete trajectoryStream;
 
     motor = nullptr;
+    trajectoryStream = nullptr;
 }
 
 void TalonFXMotion::SetSetpoint(units::meter_t position) {
     positionSetpoint = position;
 
+    // Selecting the slot is only needed when the setpoint type changes; the
+    // gains for every setpoint type already live on the controller
+    if (setpointType != ePosition) {
+        motor->SelectProfileSlot(defaults::positionSlot, 0);
+    }
+
     // Control through position
-    // meters -> revolutions of output shaft -> revolutions of Falcon shaft -> 
-    // encoder counts
     motor->Set(
         ctre::phoenix::motorcontrol::ControlMode::Position,
-        (double)positionSetpoint / ((double)wheelDiameter * M_PI) * gearing * defaults::countsPerRev
+        (double)positionSetpoint * nativePerMeter,
+        ctre::phoenix::motorcontrol::DemandType::DemandType_ArbitraryFeedForward,
+        GetFeedforwardPercent(positionSetpoint, 0.0_mps)
     );
 
     setpointType = ePosition;
+    PublishSetpoint();
 }
 
 void TalonFXMotion::SetSetpoint(units::meters_per_second_t lvelocity) {
-    velocitySetpoint = lvelocity;
+    velocitySetpoint = ClampVelocity(lvelocity);
+
+    if (setpointType != eLinearVelocity) {
+        motor->SelectProfileSlot(defaults::linearVelocitySlot, 0);
+    }
 
     // Control through linear velocity
-    // meters per second -> revs per sec, output shaft -> revs per sec, input 
-    // shaft -> counts per sec -> counts per 100ms
     motor->Set(
         ctre::phoenix::motorcontrol::ControlMode::Velocity,
-        (double)velocitySetpoint / ((double)wheelDiameter * M_PI) * gearing * defaults::countsPerRev / 10
+        (double)velocitySetpoint * nativePerMps,
+        ctre::phoenix::motorcontrol::DemandType::DemandType_ArbitraryFeedForward,
+        GetFeedforwardPercent(published.Load().position, velocitySetpoint)
     );
 
     setpointType = eLinearVelocity;
+    PublishSetpoint();
 }
 
 void TalonFXMotion::SetSetpoint(units::radians_per_second_t avelocity) {
-    avelSetpoint = avelocity;
+    avelSetpoint = ClampVelocity(avelocity);
 
-    // Control through linear velocity
-    // rad per second -> revs per sec, output shaft -> revs per sec, input shaft -> counts per sec -> counts per 100ms
+    if (setpointType != eAngularVelocity) {
+        motor->SelectProfileSlot(defaults::angularVelocitySlot, 0);
+    }
+
+    // Control through angular velocity; the feedforward works in m/s at the
+    // wheel
     motor->Set(
         ctre::phoenix::motorcontrol::ControlMode::Velocity,
-        (double)avelSetpoint / (2 * M_PI) * gearing * defaults::countsPerRev / 10
+        (double)avelSetpoint * nativePerRadPerSec,
+        ctre::phoenix::motorcontrol::DemandType::DemandType_ArbitraryFeedForward,
+        GetFeedforwardPercent(published.Load().position, units::meters_per_second_t((double)avelSetpoint * (double)wheelDiameter / 2.0))
     );
 
     setpointType = eAngularVelocity;
+    PublishSetpoint();
+}
+
+void TalonFXMotion::SetSetpoint(units::radian_t angle) {
+    apositionSetpoint = GetNearestAngle(angle);
+
+    // Angles share the position slot
+    if (setpointType != ePosition && setpointType != eAngularPosition) {
+        motor->SelectProfileSlot(defaults::positionSlot, 0);
+    }
+
+    // radians of the output shaft -> encoder counts
+    motor->Set(
+        ctre::phoenix::motorcontrol::ControlMode::Position,
+        (double)apositionSetpoint * nativePerRadian,
+        ctre::phoenix::motorcontrol::DemandType::DemandType_ArbitraryFeedForward,
+        GetFeedforwardPercent(units::meter_t((double)apositionSetpoint * (double)wheelDiameter / 2.0), 0.0_mps)
+    );
+
+    setpointType = eAngularPosition;
+    PublishSetpoint();
+}
+
+void TalonFXMotion::SetProfiledSetpoint(units::meter_t position) {
+    positionSetpoint = position;
+
+    if (setpointType != eProfiledPosition) {
+        motor->SelectProfileSlot(defaults::profiledPositionSlot, 0);
+    }
+
+    // Control through Motion Magic; the controller generates the profile, so
+    // the feedforward is only known at the target, where it holds the 
+    // mechanism against gravity once the profile ends
+    motor->Set(
+        ctre::phoenix::motorcontrol::ControlMode::MotionMagic,
+        (double)positionSetpoint * nativePerMeter,
+        ctre::phoenix::motorcontrol::DemandType::DemandType_ArbitraryFeedForward,
+        GetFeedforwardPercent(positionSetpoint, 0.0_mps)
+    );
+
+    setpointType = eProfiledPosition;
+    PublishSetpoint();
+}
+
+ctre::phoenix::ErrorCode TalonFXMotion::StartTrajectory(std::span<const TrajectoryPoint> points) {
+    // Reject the trajectory before touching the one that may be running
+    bool isValid = !points.empty() && points[0].time >= 0.0_s;
+    for (size_t i = 1; isValid && i < points.size(); i++) {
+        isValid = points[i].time > points[i - 1].time;
+    }
+    if (!isValid) {
+        lastError = ctre::phoenix::ErrorCode::InvalidParamValue;
+        return lastError;
+    }
+
+    // The stream can't be rewritten while the controller is still reading it
+    if (setpointType == eTrajectory) {
+        Stop();
+    }
+    motor->ClearMotionProfileTrajectories();
+    trajectoryStream->Clear();
+
+    int written = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        ctre::phoenix::motion::TrajectoryPoint point;
+
+        point.position = (double)points[i].position * nativePerMeter;
+        point.velocity = (double)points[i].velocity * nativePerMps;
+        point.arbFeedFwd = 0.0;
+        point.auxiliaryPos = 0.0;
+        point.auxiliaryVel = 0.0;
+        point.auxiliaryArbFeedFwd = 0.0;
+        point.profileSlotSelect0 = defaults::profiledPositionSlot;
+        point.profileSlotSelect1 = 0;
+        point.zeroPos = false;
+        point.useAuxPID = false;
+        // Each point is held until the next one's time, the first one from 
+        // the start of the trajectory; the last point is held as long as the 
+        // one before it
+        units::second_t start = (i == 0) ? 0.0_s : points[i].time;
+        units::second_t end = points[i].time;
+        if (i + 1 < points.size()) {
+            end = points[i + 1].time;
+        } else if (i > 0) {
+            end = points[i].time + (points[i].time - points[i - 1].time);
+        }
+        int durationMs = std::max(1, (int)std::lround(units::millisecond_t(end - start).value()));
+
+        // A point can only be held for so long, so longer ones are repeated
+        while (durationMs > 0) {
+            point.timeDur = std::min(durationMs, defaults::maxPointDurationMs);
+            durationMs -= point.timeDur;
+            point.isLastPoint = (i + 1 == points.size()) && (durationMs == 0);
+
+            ctre::phoenix::ErrorCode error = trajectoryStream->Write(point);
+            if (error != ctre::phoenix::ErrorCode::OK) {
+                lastError = error;
+                return error;
+            }
+            written++;
+        }
+    }
+
+    trajectoryPoints = written;
+    motor->ClearMotionProfileHasUnderrun();
+
+    ctre::phoenix::ErrorCode error = motor->StartMotionProfile(
+        *trajectoryStream,
+        defaults::minBufferedPoints,
+        ctre::phoenix::motorcontrol::ControlMode::MotionProfile
+    );
+    if (error != ctre::phoenix::ErrorCode::OK) {
+        lastError = error;
+    }
+
+    setpointType = eTrajectory;
+    PublishSetpoint();
+
+    return error;
+}
+
+laser::TrajectoryProgress TalonFXMotion::GetTrajectoryProgress() {
+    TrajectoryProgress progress;
+    ctre::phoenix::motion::MotionProfileStatus status;
+
+    motor->GetMotionProfileStatus(status);
+
+    progress.totalPoints = trajectoryPoints;
+    progress.bufferedPoints = status.topBufferCnt + status.btmBufferCnt;
+    progress.hasUnderrun = status.hasUnderrun;
+    progress.isFinished = (setpointType == eTrajectory) && motor->IsMotionProfileFinished();
+
+    return progress;
 }
 
-units::volt_t TalonFXMotion::GetMotorVoltage() {
-    return units::volt_t(motor->GetMotorOutputVoltage());
+void TalonFXMotion::SetMotionConstraints(
+    units::meters_per_second_t maxVelocity, 
+    units::meters_per_second_squared_t maxAcceleration, 
+    int sCurveStrength
+) {
+    // Set the member variables.
+    maxProfileVelocity = maxVelocity;
+    maxProfileAcceleration = maxAcceleration;
+    profileSCurveStrength = std::clamp(sCurveStrength, 0, defaults::maxSCurveStrength);
+
+    // m/s -> counts per 100ms; m/s^2 -> counts per 100ms per second
+    double velocity = (double)maxProfileVelocity * nativePerMps;
+    double acceleration = (double)maxProfileAcceleration * nativePerMps;
+    int sCurve = profileSCurveStrength;
+
+    IssueConfig(eConfigProfileVelocity, 0, velocity, [=, this](int timeoutMs) {
+        return motor->ConfigMotionCruiseVelocity(velocity, timeoutMs);
+    });
+    IssueConfig(eConfigProfileAcceleration, 0, acceleration, [=, this](int timeoutMs) {
+        return motor->ConfigMotionAcceleration(acceleration, timeoutMs);
+    });
+    IssueConfig(eConfigProfileSCurve, 0, sCurve, [=, this](int timeoutMs) {
+        return motor->ConfigMotionSCurveStrength(sCurve, timeoutMs);
+    });
 }
 
 void TalonFXMotion::SetMotorVoltage(units::volt_t voltage) {
     motor->SetVoltage(voltage);
     motor->Feed();
-}
-
-units::ampere_t TalonFXMotion::GetMotorCurrent() {
-    return units::ampere_t(motor->GetStatorCurrent());
+    commandedVoltage = voltage;
+    MarkActive();
 }
 
 void TalonFXMotion::Stop() {
     // Stop the motor.
     motor->Set(0.000);
+    commandedVoltage = 0.0_V;
+    isStopped = true;
 }
 
 void TalonFXMotion::SetTolerance(units::meter_t tolerance) {
-    // meters -> rotations -> encoder counts
-    motor->ConfigAllowableClosedloopError(
-        0,
-        (double)tolerance / ((double)wheelDiameter * M_PI) * defaults::countsPerRev 
-    );
+    // Profiled position setpoints share the position tolerance
+    double counts = (double)tolerance * nativePerMeter;
+    for (int slot : { defaults::positionSlot, defaults::profiledPositionSlot }) {
+        IssueConfig(eConfigTolerance, slot, counts, [=, this](int timeoutMs) {
+            return motor->ConfigAllowableClosedloopError(slot, counts, timeoutMs);
+        });
+    }
 
     // Set the member variable.
     positionTolerance = tolerance;
 }
 
 void TalonFXMotion::SetTolerance(units::meters_per_second_t tolerance) {
-    // meters per sec -> rotations per sec -> encoder counts per sec -> encoder
-    // counts per 100ms
-    motor->ConfigAllowableClosedloopError(
-        0,
-        (double)tolerance / ((double)wheelDiameter * M_PI) * defaults::countsPerRev / 10
-    );
+    double counts = (double)tolerance * nativePerMps;
+    IssueConfig(eConfigTolerance, defaults::linearVelocitySlot, counts, [=, this](int timeoutMs) {
+        return motor->ConfigAllowableClosedloopError(defaults::linearVelocitySlot, counts, timeoutMs);
+    });
 
     // Set the member variable.
     velocityTolerance = tolerance;
 }
 
 void TalonFXMotion::SetTolerance(units::radians_per_second_t tolerance) {
-    // radians per sec -> rotations per sec -> encoder counts per sec -> 
-    // encoder counts per 100ms
-    motor->ConfigAllowableClosedloopError(
-        0,
-        (double)tolerance / (2 * M_PI) * defaults::countsPerRev / 10
-    );
+    double counts = (double)tolerance * nativePerRadPerSec;
+    IssueConfig(eConfigTolerance, defaults::angularVelocitySlot, counts, [=, this](int timeoutMs) {
+        return motor->ConfigAllowableClosedloopError(defaults::angularVelocitySlot, counts, timeoutMs);
+    });
 
     // Set the member variable.
     avelTolerance = tolerance;
@@ -150,106 +347,273 @@ units::radians_per_second_t TalonFXMotion::GetAngularVelocityTolerance() {
     return avelTolerance;
 }
 
+void TalonFXMotion::SetTolerance(units::radian_t tolerance) {
+    // The position slot's allowable error is shared with positions in meters,
+    // so this is only used for IsAtSetpoint()
+    apositionTolerance = tolerance;
+}
+
+units::radian_t TalonFXMotion::GetAngularPositionTolerance() {
+    return apositionTolerance;
+}
+
 void TalonFXMotion::ConfigLimitSwitches(bool isFwdNO, bool isRevNO) {
     // Set the member variables.
     isFwdLimitSwitchNO = isFwdNO;
     isRevLimitSwitchNO = isRevNO;
 
     // Set the internal lim. sw. configs
-    motor->ConfigForwardLimitSwitchSource(ctre::phoenix::motorcontrol::LimitSwitchSource::LimitSwitchSource_FeedbackConnector,
-        (isFwdLimitSwitchNO ? ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyOpen :
-        ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyClosed)
-    );
-    motor->ConfigReverseLimitSwitchSource(ctre::phoenix::motorcontrol::LimitSwitchSource::LimitSwitchSource_FeedbackConnector,
-        (isRevLimitSwitchNO ? ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyOpen :
-        ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyClosed)
-    );
+    IssueConfig(eConfigFwdLimitSwitch, 0, isFwdLimitSwitchNO, [=, this](int timeoutMs) {
+        return motor->ConfigForwardLimitSwitchSource(ctre::phoenix::motorcontrol::LimitSwitchSource::LimitSwitchSource_FeedbackConnector,
+            (isFwdLimitSwitchNO ? ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyOpen :
+            ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyClosed),
+            timeoutMs
+        );
+    });
+    IssueConfig(eConfigRevLimitSwitch, 0, isRevLimitSwitchNO, [=, this](int timeoutMs) {
+        return motor->ConfigReverseLimitSwitchSource(ctre::phoenix::motorcontrol::LimitSwitchSource::LimitSwitchSource_FeedbackConnector,
+            (isRevLimitSwitchNO ? ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyOpen :
+            ctre::phoenix::motorcontrol::LimitSwitchNormal::LimitSwitchNormal_NormallyClosed),
+            timeoutMs
+        );
+    });
 }
 
 void TalonFXMotion::SetAccumIZone(double _izone) {
     // Set the member variable.
     izone = _izone;
 
-    // revolutions, output shaft -> revolutions, input shaft -> encoder ticks
-    motor->Config_IntegralZone(0, izone / gearing * 2048);
-}
-
-void TalonFXMotion::SetPositionSoftLimits(units::meter_t minpos, units::meter_t maxpos ) {
-    throw std::runtime_error("SetPositionSoftLimits currently unimplemented!");
+    // The integral zone is global, so every slot gets the same value
+    double counts = izone / gearing * defaults::countsPerRev;
+    for (int slot : { defaults::positionSlot, defaults::linearVelocitySlot, defaults::angularVelocitySlot, defaults::profiledPositionSlot }) {
+        IssueConfig(eConfigIntegralZone, slot, counts, [=, this](int timeoutMs) {
+            return motor->Config_IntegralZone(slot, counts, timeoutMs);
+        });
+    }
 }
 
-bool TalonFXMotion::IsFwdLimitSwitchPressed() {
-    return (
-        (isFwdLimitSwitchNO && motor->GetSensorCollection().IsFwdLimitSwitchClosed()) ||
-        (!isFwdLimitSwitchNO && !motor->GetSensorCollection().IsFwdLimitSwitchClosed())
-    );
+void TalonFXMotion::SetPositionSoftLimits(units::meter_t minpos, units::meter_t maxpos) {
+    // Limits given in the wrong order are swapped rather than crossing
+    if (minpos > maxpos) {
+        std::swap(minpos, maxpos);
+    }
+    lowerPositionSoftLimit = minpos;
+    upperPositionSoftLimit = maxpos;
+
+    // The thresholds are in integrated sensor counts, so they are re-applied
+    // by UpdateConversionFactors() whenever the gearing or wheel changes. A 
+    // NAN never matches the shadow configuration, so disabling always writes
+    bool isEnabled = (minpos != maxpos);
+    double forward = (double)maxpos * nativePerMeter;
+    double reverse = (double)minpos * nativePerMeter;
+
+    IssueConfig(eConfigFwdSoftLimit, 0, isEnabled ? forward : NAN, [=, this](int timeoutMs) {
+        ctre::phoenix::ErrorCode error = motor->ConfigForwardSoftLimitThreshold(forward, timeoutMs);
+        if (error != ctre::phoenix::ErrorCode::OK) {
+            return error;
+        }
+        return motor->ConfigForwardSoftLimitEnable(isEnabled, timeoutMs);
+    });
+    IssueConfig(eConfigRevSoftLimit, 0, isEnabled ? reverse : NAN, [=, this](int timeoutMs) {
+        ctre::phoenix::ErrorCode error = motor->ConfigReverseSoftLimitThreshold(reverse, timeoutMs);
+        if (error != ctre::phoenix::ErrorCode::OK) {
+            return error;
+        }
+        return motor->ConfigReverseSoftLimitEnable(isEnabled, timeoutMs);
+    });
 }
 
-bool TalonFXMotion::IsRevLimitSwitchPressed() {
-    return (
-        (isRevLimitSwitchNO && motor->GetSensorCollection().IsRevLimitSwitchClosed()) ||
-        (!isRevLimitSwitchNO && !motor->GetSensorCollection().IsRevLimitSwitchClosed())
-    );
+ctre::phoenix::ErrorCode TalonFXMotion::SetClearPositionOnRevLimit(bool isEnabled) {
+    return IssueConfig(eConfigClearPositionOnRevLimit, 0, isEnabled ? 1.0 : 0.0, [=, this](int timeoutMs) {
+        return motor->ConfigClearPositionOnLimitR(isEnabled, timeoutMs);
+    });
 }
 
 void TalonFXMotion::Reset() {
     Stop();
-    // Reset the encoder count to zero.
-    motor->SetSelectedSensorPosition(0);
-}
-
-int TalonFXMotion::GetRawEncoderCounts() {
-    return (int)motor->GetSelectedSensorPosition();
+    // Reset the encoder count to zero, or to the true position when there is
+    // an absolute sensor
+    units::meter_t seed = GetSeedPosition();
+    motor->SetSelectedSensorPosition((double)seed * nativePerMeter);
+    SeedPlant(seed);
+
+    // The cached position is no longer valid
+    InvalidateState();
 }
 
 void TalonFXMotion::SetClosedRampRate(units::second_t time) {
-    motor->ConfigClosedloopRamp((double)time);
+    IssueConfig(eConfigClosedRampRate, 0, (double)time, [=, this](int timeoutMs) {
+        return motor->ConfigClosedloopRamp((double)time, timeoutMs);
+    });
 }
 
 void TalonFXMotion::SetOpenRampRate(units::second_t time) {
-    motor->ConfigOpenloopRamp((double)time);
+    IssueConfig(eConfigOpenRampRate, 0, (double)time, [=, this](int timeoutMs) {
+        return motor->ConfigOpenloopRamp((double)time, timeoutMs);
+    });
 }
 
-units::meter_t TalonFXMotion::GetActualPosition() {
-    units::meter_t actual = 0.0_m;
+void TalonFXMotion::Refresh() {
+    // A stale getter on another thread may refresh at the same time
+    std::unique_lock<std::mutex> lock(refreshMutex);
+
+    // A plant driven mechanism is read in place of the simulated controller
+    PublishMeasurement(IsPlantDriven() ? ReadPlant(defaults::countsPerRev) : ReadSensors());
+    UpdateFrameRates();
 
-    // Sensor units -> revolutions, input shaft -> revolutions, output shaft ->
-    // meters, distance of wheel
-    actual = motor->GetSelectedSensorPosition() / defaults::countsPerRev / gearing * (wheelDiameter * M_PI);
+    // Listeners may call back into this object, and another thread may be 
+    // waiting to refresh it, so they only run once the mutex is released
+    std::vector<std::function<void()>> fired = CollectEvents();
+    lock.unlock();
+    for (std::function<void()>& callback : fired) {
+        callback();
+    }
+}
 
-    return actual;
+laser::MotorState TalonFXMotion::ReadSensors() {
+    double rawPosition = motor->GetSelectedSensorPosition();
+    double rawVelocity = motor->GetSelectedSensorVelocity();
+
+    // Vendor calls happen outside of the publish lock
+    MotorState sample;
+    sample.rawEncoderCounts = (int)rawPosition;
+    sample.position = units::meter_t(rawPosition * metersPerNative);
+    sample.velocity = units::meters_per_second_t(rawVelocity * mpsPerNative);
+    sample.angularVelocity = units::radians_per_second_t(rawVelocity * radPerSecPerNative);
+    sample.angularPosition = units::radian_t(rawPosition * radiansPerNative);
+
+    sample.current = units::ampere_t(motor->GetStatorCurrent());
+    // The controller computes its output voltage from the bus voltage in
+    // Status_4, which is slowed down; the percent output rides on Status_1 
+    // with the rest of the applied output, and the roboRIO measures the same
+    // battery without touching the bus
+    sample.voltage = motor->GetMotorOutputPercent() * frc::RobotController::GetBatteryVoltage();
+
+    // Read each switch once rather than once per NO/NC branch
+    auto& sensors = motor->GetSensorCollection();
+    bool isFwdClosed = sensors.IsFwdLimitSwitchClosed();
+    bool isRevClosed = sensors.IsRevLimitSwitchClosed();
+    sample.isFwdLimitSwitchPressed = (isFwdLimitSwitchNO == isFwdClosed);
+    sample.isRevLimitSwitchPressed = (isRevLimitSwitchNO == isRevClosed);
+
+    sample.timestamp = frc::Timer::GetFPGATimestamp();
+    return sample;
 }
 
-units::meters_per_second_t TalonFXMotion::GetActualVelocity() {
-    units::meters_per_second_t actual = 0.0_mps;
+void TalonFXMotion::SimulationPeriodic(units::second_t dt) {
+    if (!mechanism) {
+        return;
+    }
+
+    if (IsPlantDriven()) {
+        StepPlant(dt);
+        return;
+    }
+
+    auto& simCollection = motor->GetSimCollection();
+    units::volt_t busVoltage = frc::RobotController::GetBatteryVoltage();
+    simCollection.SetBusVoltage((double)busVoltage);
+
+    // The simulation collection works in the motor's direction, while the 
+    // mechanism works in the direction of positive setpoints
+    double direction = isInverted ? -1.0 : 1.0;
+    double leadVoltage = simCollection.GetMotorOutputLeadVoltage();
+    mechanism->SetInputVoltage(units::volt_t(leadVoltage * direction));
+    mechanism->Update(dt);
+
+    // radians, output shaft -> encoder ticks; rad/s -> ticks/100ms
+    simCollection.SetIntegratedSensorRawPosition((int)(direction * (double)mechanism->GetAngle() * nativePerRadian));
+    simCollection.SetIntegratedSensorVelocity((int)(direction * (double)mechanism->GetAngularVelocity() * nativePerRadPerSec));
+
+    double statorCurrent = std::abs((double)mechanism->GetCurrentDraw());
+    simCollection.SetStatorCurrent(statorCurrent);
+    if ((double)busVoltage > 0.0) {
+        simCollection.SetSupplyCurrent(statorCurrent * std::abs(leadVoltage / (double)busVoltage));
+    }
+}
 
-    // Sensor units per 100ms -> sensor units per second -> revolutions per 
-    // sec, input shaft -> rev per sec, output shaft -> m/s, wheel speed
-    actual = motor->GetSelectedSensorVelocity() * 10 / defaults::countsPerRev / gearing * (wheelDiameter * M_PI) / 1.0_s;
+double TalonFXMotion::GetFeedforwardPercent(units::meter_t position, units::meters_per_second_t velocity) {
+    if (!feedforward) {
+        return 0.0;
+    }
 
-    return actual;
+    // The arbitrary feedforward is a fraction of the bus voltage
+    return CalculateFeedforward(position, velocity).value() / frc::RobotController::GetBatteryVoltage().value();
 }
 
-units::radians_per_second_t TalonFXMotion::GetActualAngularVelocity() {
-    units::radians_per_second_t actual = units::radians_per_second_t(0.0);
+ctre::phoenix::ErrorCode TalonFXMotion::Follow(MotorMotion& leader, bool isOpposed) {
+    // A motor following itself would never be driven again
+    if (&leader == this) {
+        lastError = ctre::phoenix::ErrorCode::InvalidParamValue;
+        return lastError;
+    }
+
+    // WPI_TalonFX hides the IMotorController overloads behind its 
+    // frc::MotorController ones, so go through the base class
+    ctre::phoenix::motorcontrol::can::BaseMotorController& base = *motor;
 
-    // Sensor units per 100ms -> sensor units per sec -> revs per sec, input 
-    // shaft -> revs per sec, output shaft -> rad/s, output shaft
-    actual = units::radians_per_second_t(
-        motor->GetSelectedSensorVelocity() * 10 / defaults::countsPerRev / gearing * (2 * M_PI)
+    base.Follow(*leader.GetMotorPointer());
+    base.SetInverted(isOpposed ? 
+        ctre::phoenix::motorcontrol::InvertType::OpposeMaster : 
+        ctre::phoenix::motorcontrol::InvertType::FollowMaster
     );
+    commandedVoltage = 0.0_V;
+
+    return motor->GetLastError();
+}
+
+ctre::phoenix::ErrorCode TalonFXMotion::ApplySignalFrames(int signals) {
+    ctre::phoenix::ErrorCode result = ctre::phoenix::ErrorCode::OK;
+    for (const defaults::StatusFrameDefault& status : defaults::statusFrames) {
+        bool isConsumed = (status.signals & signals) != 0;
+
+        ctre::phoenix::ErrorCode error = SetStatusFramePeriod(status.frame, isConsumed ? status.period : defaults::slowFramePeriod);
+        if (result == ctre::phoenix::ErrorCode::OK) {
+            result = error;
+        }
+    }
+
+    return result;
+}
+
+ctre::phoenix::ErrorCode TalonFXMotion::SetStatusFramePeriod(ctre::phoenix::motorcontrol::StatusFrameEnhanced frame, units::millisecond_t period) {
+    int periodMs = std::clamp((int)period.value(), 1, 255);
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        statusFramePeriods[(int)frame] = units::millisecond_t(periodMs);
+    }
+
+    return IssueConfig(eConfigStatusFramePeriod, (int)frame, periodMs, [=, this](int timeoutMs) {
+        return motor->SetStatusFramePeriod(frame, (uint8_t)periodMs, timeoutMs);
+    });
+}
 
-    return actual;
+void TalonFXMotion::SetPIDValues(
+    double proportional,
+    double integral, 
+    double derivative, 
+    double feedforward
+) {
+    // Without an active setpoint type, every slot gets the same PID values
+    if (setpointType == eNone) {
+        SetPIDValues(ePosition, proportional, integral, derivative, feedforward);
+        SetPIDValues(eLinearVelocity, proportional, integral, derivative, feedforward);
+        SetPIDValues(eAngularVelocity, proportional, integral, derivative, feedforward);
+        SetPIDValues(eProfiledPosition, proportional, integral, derivative, feedforward);
+    } else {
+        SetPIDValues(setpointType, proportional, integral, derivative, feedforward);
+    }
 }
 
 void TalonFXMotion::SetPIDValues(
+    SetpointType type,
     double proportional,
     double integral, 
     double derivative, 
     double feedforward
 ) {
-    // Set PID values for either position or velocity
-    switch (setpointType) {
+    // Set PID values for either position or velocity, each in its own slot
+    switch (type) {
         case eNone:
             break;
 
@@ -259,10 +623,7 @@ void TalonFXMotion::SetPIDValues(
             positionDerivative = derivative;
             positionFeedForward = feedforward;
 
-            motor->Config_kP(0, positionProportional);
-            motor->Config_kI(0, positionIntegral);
-            motor->Config_kD(0, positionDerivative);
-            motor->Config_kF(0, positionFeedForward);
+            ConfigSlot(defaults::positionSlot, positionProportional, positionIntegral, positionDerivative, positionFeedForward);
 
             break;
         
@@ -272,10 +633,7 @@ void TalonFXMotion::SetPIDValues(
             velocityDerivative = derivative;
             velocityFeedForward = feedforward;
 
-            motor->Config_kP(0, velocityProportional);
-            motor->Config_kI(0, velocityIntegral);
-            motor->Config_kD(0, velocityDerivative);
-            motor->Config_kF(0, velocityFeedForward);
+            ConfigSlot(defaults::linearVelocitySlot, velocityProportional, velocityIntegral, velocityDerivative, velocityFeedForward);
 
             break;
 
@@ -285,10 +643,17 @@ void TalonFXMotion::SetPIDValues(
             avelDerivative = derivative;
             avelFeedForward = feedforward;
 
-            motor->Config_kP(0, avelProportional);
-            motor->Config_kI(0, avelIntegral);
-            motor->Config_kD(0, avelDerivative);
-            motor->Config_kF(0, avelFeedForward);
+            ConfigSlot(defaults::angularVelocitySlot, avelProportional, avelIntegral, avelDerivative, avelFeedForward);
+
+            break;
+
+        case eProfiledPosition:
+            profiledProportional = proportional;
+            profiledIntegral = integral;
+            profiledDerivative = derivative;
+            profiledFeedForward = feedforward;
+
+            ConfigSlot(defaults::profiledPositionSlot, profiledProportional, profiledIntegral, profiledDerivative, profiledFeedForward);
 
             break;
 
@@ -297,10 +662,74 @@ void TalonFXMotion::SetPIDValues(
     }
 }
 
+void TalonFXMotion::UpdateConversionFactors() {
+    // meters -> revolutions of output shaft -> revolutions of Falcon shaft -> 
+    // encoder counts
+    nativePerMeter = gearing * defaults::countsPerRev / ((double)wheelDiameter * M_PI);
+    metersPerNative = 1.0 / nativePerMeter;
+
+    // meters per second -> encoder counts per sec -> counts per 100ms
+    nativePerMps = nativePerMeter / 10;
+    mpsPerNative = 1.0 / nativePerMps;
+
+    // rad per second -> revs per sec, output shaft -> revs per sec, input 
+    // shaft -> counts per sec -> counts per 100ms
+    nativePerRadPerSec = gearing * defaults::countsPerRev / (2 * M_PI) / 10;
+    radPerSecPerNative = 1.0 / nativePerRadPerSec;
+
+    // radians of output shaft -> revolutions of Falcon shaft -> encoder 
+    // counts; angles don't depend on the wheel diameter
+    nativePerRadian = gearing * defaults::countsPerRev / (2 * M_PI);
+    radiansPerNative = 1.0 / nativePerRadian;
+
+    // Re-apply everything stored on the controller in encoder counts; a zero
+    // is zero counts regardless of the factors, so it can be left alone
+    if (positionTolerance != 0.0_m) {
+        SetTolerance(positionTolerance);
+    }
+    if (velocityTolerance != 0.0_mps) {
+        SetTolerance(velocityTolerance);
+    }
+    if (avelTolerance != units::radians_per_second_t(0.0)) {
+        SetTolerance(avelTolerance);
+    }
+    if (izone != 0.0) {
+        SetAccumIZone(izone);
+    }
+    if (maxProfileVelocity != 0.0_mps) {
+        SetMotionConstraints(maxProfileVelocity, maxProfileAcceleration, profileSCurveStrength);
+    }
+    if (lowerPositionSoftLimit != upperPositionSoftLimit) {
+        SetPositionSoftLimits(lowerPositionSoftLimit, upperPositionSoftLimit);
+    }
+}
+
+void TalonFXMotion::ConfigSlot(
+    int slot,
+    double proportional,
+    double integral, 
+    double derivative, 
+    double feedforward
+) {
+    IssueConfig(eConfigProportional, slot, proportional, [=, this](int timeoutMs) {
+        return motor->Config_kP(slot, proportional, timeoutMs);
+    });
+    IssueConfig(eConfigIntegral, slot, integral, [=, this](int timeoutMs) {
+        return motor->Config_kI(slot, integral, timeoutMs);
+    });
+    IssueConfig(eConfigDerivative, slot, derivative, [=, this](int timeoutMs) {
+        return motor->Config_kD(slot, derivative, timeoutMs);
+    });
+    IssueConfig(eConfigFeedForward, slot, feedforward, [=, this](int timeoutMs) {
+        return motor->Config_kF(slot, feedforward, timeoutMs);
+    });
+}
+
 void TalonFXMotion::SetMotorInverted(bool isInverted) {
     // Whenever a positive input is sent to the motor controller, the output 
     // will be reversed/negated
     motor->SetInverted(isInverted);
+    this->isInverted = isInverted;
 }
 
 ctre::phoenix::ErrorCode TalonFXMotion::ConfigCurrentLimit(units::ampere_t amps) {
@@ -313,6 +742,8 @@ ctre::phoenix::ErrorCode TalonFXMotion::ConfigCurrentLimit(units::ampere_t amps)
         config = ctre::phoenix::motorcontrol::SupplyCurrentLimitConfiguration(true, (double)amps, 0, 0);
     }
 
-    return motor->ConfigSupplyCurrentLimit(config);
+    return IssueConfig(eConfigCurrentLimit, 0, (double)amps, [=, this](int timeoutMs) {
+        return motor->ConfigSupplyCurrentLimit(config, timeoutMs);
+    });
 }
 
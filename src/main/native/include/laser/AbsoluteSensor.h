@@ -0,0 +1,77 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file AbsoluteSensor.h
+ * @brief 
+ *      This file contains adapters that turn absolute sensors into the 
+ *      callables accepted by MotorMotion::SetAbsoluteSensor().
+ * 
+ * An absolute sensor knows the mechanism position as soon as it powers on, so
+ * seeding the integrated sensor from it replaces homing at startup.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <ctre/phoenix/sensors/CANCoder.h>
+#include <frc/DutyCycleEncoder.h>
+#include <units/angle.h>
+#include <functional>
+#include <optional>
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+/**
+ * @brief 
+ *      This namespace contains the absolute sensor adapters.
+ */
+namespace sensors {
+    /**
+     * @brief 
+     *      Reads the absolute position of a CANCoder.
+     * 
+     * The CANCoder must report its absolute position in degrees, which is its
+     * default sensor coefficient. A CANCoder that hasn't reported yet, or 
+     * whose magnet is out of range, gives no reading.
+     * @param cancoder
+     *      CANCoder object pointer; it must outlive the returned callable
+     * @return 
+     *      Callable returning the absolute position in units::turn_t, or 
+     *      std::nullopt when the reading isn't valid
+     */
+    std::function<std::optional<units::turn_t>()> FromCANCoder(ctre::phoenix::sensors::CANCoder* /* cancoder */);
+
+    /**
+     * @brief 
+     *      Reads the absolute position of a duty cycle encoder, such as a 
+     *      REV Through Bore Encoder plugged into a DIO port.
+     * 
+     * An unplugged encoder gives no reading.
+     * @param encoder
+     *      frc::DutyCycleEncoder object pointer; it must outlive the returned
+     *      callable
+     * @return 
+     *      Callable returning the absolute position in units::turn_t, or 
+     *      std::nullopt when the encoder isn't connected
+     */
+    std::function<std::optional<units::turn_t>()> FromDutyCycle(frc::DutyCycleEncoder* /* encoder */);
+
+} // namespace sensors
+
+} // namespace laser
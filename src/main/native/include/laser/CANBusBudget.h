@@ -0,0 +1,109 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file CANBusBudget.h
+ * @brief 
+ *      This file contains the CANBusBudget class, which estimates the load
+ *      the status frames of a fleet of motor controllers put on a CAN bus.
+ * @see MotorMotion::SetConsumedSignals()
+ */
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class CANBusBudget CANBusBudget.h laser/CANBusBudget.h
+     * @brief 
+     *      Sums the status frame rates of every registered motor, plus any
+     *      other devices on the bus, into an estimated bus utilization.
+     * 
+     * The estimate assumes every frame is an extended frame with a full
+     * 8 byte payload, about 128 bits on the wire once bit stuffing is
+     * included. Setpoint frames sent by the roboRIO are not counted, so keep
+     * the estimate comfortably below 100%; staying under roughly 70% avoids
+     * dropped frames.
+     */
+    class CANBusBudget {
+        public:
+            /**
+             * @brief 
+             *      Approximate number of bits a status frame takes on the bus
+             */
+            static constexpr double bitsPerFrame = 128.0;
+
+            /**
+             * @brief 
+             *      Constructor that accepts the bit rate of the bus.
+             * @param bitRate
+             *      The bit rate of the bus in bits per second (default 1 Mbps,
+             *      the roboRIO's CAN bus)
+             */
+            CANBusBudget(double /* bitRate */ = 1000000.0);
+
+            /**
+             * @brief 
+             *      Registers a motor whose status frames are on this bus
+             * @param motion
+             *      MotorMotion object pointer of the motor
+             */
+            template <typename ErrorEnum, class MotorType>
+            void AddMotor(MotorMotion<ErrorEnum, MotorType>* motion) {
+                sources.push_back([motion] { return motion->GetStatusFrameRate(); });
+            }
+
+            /**
+             * @brief 
+             *      Registers the frames of a device that isn't a MotorMotion,
+             *      such as a power distribution hub or an IMU
+             * @param framesPerSecond
+             *      The number of frames the device sends per second
+             */
+            void AddDevice(double /* framesPerSecond */);
+
+            /**
+             * @brief 
+             *      Returns the number of frames sent per second by every 
+             *      registered device, with their current frame periods
+             * @return 
+             *      The number of frames per second
+             */
+            double GetFramesPerSecond();
+
+            /**
+             * @brief 
+             *      Returns the estimated fraction of the bus bandwidth used by
+             *      the registered devices
+             * @return 
+             *      The estimated utilization, where 1.0 is a saturated bus
+             */
+            double GetEstimatedLoad();
+
+        protected:
+            /** @brief The bit rate of the bus in bits per second */
+            double bitRate;
+            /** @brief Frame rates of the registered devices */
+            std::vector<std::function<double()>> sources;
+    }; // class CANBusBudget
+
+} // namespace laser
@@ -0,0 +1,146 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file ConfigQueue.h
+ * @brief 
+ *      This file contains the ConfigQueue class, which runs motor controller
+ *      configuration writes on a background thread.
+ * 
+ * Vendor configuration calls wait on the CAN bus for an acknowledgement; when
+ * a MotorMotion instance is in async configuration mode, those calls are
+ * handed to this queue so the robot loop never waits on them.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class ConfigQueue ConfigQueue.h laser/ConfigQueue.h
+     * @brief 
+     *      A queue of configuration writes drained by a single dedicated
+     *      worker thread.
+     * 
+     * There is one queue (and one worker thread) per ErrorEnum type, shared by
+     * every motor of that vendor. Writes run in the order they were queued.
+     * @see MotorMotion::SetAsyncConfig()
+     */
+    template <typename ErrorEnum>
+    class ConfigQueue {
+        public:
+            /**
+             * @brief 
+             *      Returns the queue shared by every motor using ErrorEnum,
+             *      starting its worker thread on first use
+             * @return 
+             *      Reference to the shared ConfigQueue
+             */
+            static ConfigQueue& GetInstance() {
+                static ConfigQueue instance;
+                return instance;
+            }
+
+            /**
+             * @brief 
+             *      Queues a configuration write for the worker thread
+             * @param job
+             *      Callable performing the write and returning its ErrorEnum
+             * @return 
+             *      A future that becomes ready with the write's ErrorEnum once
+             *      the worker thread has run it
+             */
+            std::shared_future<ErrorEnum> Enqueue(std::function<ErrorEnum()> job) {
+                std::packaged_task<ErrorEnum()> task(std::move(job));
+                std::shared_future<ErrorEnum> result = task.get_future().share();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    jobs.push_back(std::move(task));
+                }
+                wake.notify_one();
+
+                return result;
+            }
+
+            /**
+             * @brief 
+             *      Runs every write still queued, then stops the worker
+             *      thread
+             */
+            ~ConfigQueue() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    isStopping = true;
+                }
+                wake.notify_one();
+                worker.join();
+            }
+
+            ConfigQueue(const ConfigQueue&) = delete;
+            ConfigQueue& operator=(const ConfigQueue&) = delete;
+
+        private:
+            ConfigQueue() : worker([this] { Run(); }) {}
+
+            /**
+             * @brief 
+             *      Main loop of the worker thread; the write itself runs
+             *      outside of the lock so queueing never waits on the bus
+             */
+            void Run() {
+                while (true) {
+                    std::packaged_task<ErrorEnum()> task;
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        wake.wait(lock, [this] { return isStopping || !jobs.empty(); });
+
+                        if (jobs.empty()) {
+                            return;
+                        }
+
+                        task = std::move(jobs.front());
+                        jobs.pop_front();
+                    }
+
+                    task();
+                }
+            }
+
+            /** @brief Guards the job queue and the stopping flag */
+            std::mutex mutex;
+            /** @brief Wakes the worker thread when a job is queued or on shutdown */
+            std::condition_variable wake;
+            /** @brief Writes waiting to be run, oldest first */
+            std::deque<std::packaged_task<ErrorEnum()>> jobs;
+            /** @brief Set by the destructor to stop the worker once the queue is empty */
+            bool isStopping = false;
+            /** @brief The worker thread; declared last so it starts after the other members */
+            std::thread worker;
+    }; // class ConfigQueue
+
+} // namespace laser
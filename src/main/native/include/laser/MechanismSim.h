@@ -0,0 +1,297 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MechanismSim.h
+ * @brief 
+ *      This file contains the MechanismSim classes, which model the physics of
+ *      a mechanism driven by a MotorMotion in simulation.
+ * 
+ * Each class wraps a wpimath DCMotor plant from frc::sim. A MotorMotion with
+ * a mechanism attached feeds the simulated motor voltage into it every
+ * simulation step and writes the resulting sensor position, velocity and
+ * current back into the simulated motor controller. A plant driven 
+ * MotorMotion feeds it the voltage commanded on the roboRIO and reads it 
+ * directly instead.
+ * @see MotorMotion::AttachSimulation()
+ * @see MotorMotion::SetPlantDriven()
+ */
+#pragma once
+
+#include <frc/simulation/ElevatorSim.h>
+#include <frc/simulation/FlywheelSim.h>
+#include <frc/simulation/SingleJointedArmSim.h>
+#include <frc/system/plant/DCMotor.h>
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+#include <units/current.h>
+#include <units/length.h>
+#include <units/mass.h>
+#include <units/moment_of_inertia.h>
+#include <units/time.h>
+#include <units/voltage.h>
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+/**
+ * @brief 
+ *      This namespace contains the physics models used to simulate the
+ *      mechanisms driven by MotorMotion classes
+ */
+namespace simulation {
+
+    /**
+     * @class MechanismSim MechanismSim.h laser/MechanismSim.h
+     * @brief 
+     *      The interface between a MotorMotion and the physics model of the
+     *      mechanism it drives.
+     * 
+     * Positions and velocities are those of the output shaft, in the
+     * direction of positive setpoints; the MotorMotion converts them to
+     * sensor units with its own gear ratio and handles inversion. The gear
+     * ratio given to the plant should match the one given to the MotorMotion.
+     */
+    class MechanismSim {
+        public:
+            /**
+             * @brief 
+             *      Destructor for the class; virtual so derived classes can be
+             *      deleted through a MechanismSim pointer
+             */
+            virtual ~MechanismSim() = default;
+
+            /**
+             * @brief 
+             *      Sets the voltage applied to the motor until the next update
+             * @param voltage
+             *      The motor voltage in units::volt_t
+             */
+            virtual void SetInputVoltage(units::volt_t /* voltage */) = 0;
+
+            /**
+             * @brief 
+             *      Advances the model by one time step
+             * @param dt
+             *      The length of the time step in units::second_t
+             */
+            virtual void Update(units::second_t /* dt */) = 0;
+
+            /**
+             * @brief 
+             *      Returns the angle the output shaft has turned since the
+             *      model started
+             * @return 
+             *      The output shaft angle in units::radian_t
+             */
+            virtual units::radian_t GetAngle() = 0;
+
+            /**
+             * @brief 
+             *      Returns the angular velocity of the output shaft
+             * @return 
+             *      The output shaft velocity in units::radians_per_second_t
+             */
+            virtual units::radians_per_second_t GetAngularVelocity() = 0;
+
+            /**
+             * @brief 
+             *      Returns the current drawn by the motor
+             * @return 
+             *      The motor current in units::ampere_t
+             */
+            virtual units::ampere_t GetCurrentDraw() = 0;
+
+            /**
+             * @brief 
+             *      Returns whether the output shaft sits at the lower end of 
+             *      its travel; a plant driven MotorMotion reads this as its 
+             *      reverse limit switch
+             * @return 
+             *      True at the lower end; always false for mechanisms without
+             *      one
+             */
+            virtual bool IsAtLowerLimit() { return false; }
+
+            /**
+             * @brief 
+             *      Returns whether the output shaft sits at the upper end of 
+             *      its travel; a plant driven MotorMotion reads this as its 
+             *      forward limit switch
+             * @return 
+             *      True at the upper end; always false for mechanisms without
+             *      one
+             */
+            virtual bool IsAtUpperLimit() { return false; }
+    }; // class MechanismSim
+
+    /**
+     * @class FlywheelMechanism MechanismSim.h laser/MechanismSim.h
+     * @brief 
+     *      A freely spinning mass, such as a shooter wheel or an intake roller.
+     * 
+     * The plant only tracks velocity, so the output shaft angle is integrated
+     * here.
+     */
+    class FlywheelMechanism : public MechanismSim {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the plant parameters
+             * @param gearbox
+             *      The motors driving the flywheel, e.g. frc::DCMotor::Falcon500()
+             * @param gearing
+             *      The gear ratio, as used by the MotorMotion
+             * @param moi
+             *      The moment of inertia of the flywheel
+             */
+            FlywheelMechanism(const frc::DCMotor& /* gearbox */, double /* gearing */, units::kilogram_square_meter_t /* moi */);
+
+            /* MechanismSim overrides; see MechanismSim for documentation */
+
+            void SetInputVoltage(units::volt_t /* voltage */) override;
+            void Update(units::second_t /* dt */) override;
+            units::radian_t GetAngle() override;
+            units::radians_per_second_t GetAngularVelocity() override;
+            units::ampere_t GetCurrentDraw() override;
+
+        protected:
+            /** @brief The wpimath flywheel plant */
+            frc::sim::FlywheelSim plant;
+            /** @brief Output shaft angle integrated from the plant velocity */
+            units::radian_t angle = 0.0_rad;
+    }; // class FlywheelMechanism
+
+    /**
+     * @class ElevatorMechanism MechanismSim.h laser/MechanismSim.h
+     * @brief 
+     *      A carriage lifted by a drum or sprocket, optionally against gravity.
+     * 
+     * The MotorMotion wheel diameter should be twice the drum radius, so the
+     * setpoints in meters match the carriage height.
+     */
+    class ElevatorMechanism : public MechanismSim {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the plant parameters
+             * @param gearbox
+             *      The motors driving the elevator
+             * @param gearing
+             *      The gear ratio, as used by the MotorMotion
+             * @param carriageMass
+             *      The mass of the carriage
+             * @param drumRadius
+             *      The radius of the drum or sprocket
+             * @param minHeight
+             *      The lowest height of the carriage
+             * @param maxHeight
+             *      The highest height of the carriage
+             * @param simulateGravity
+             *      When true, gravity pulls the carriage down
+             */
+            ElevatorMechanism(
+                const frc::DCMotor& /* gearbox */,
+                double /* gearing */,
+                units::kilogram_t /* carriageMass */,
+                units::meter_t /* drumRadius */,
+                units::meter_t /* minHeight */,
+                units::meter_t /* maxHeight */,
+                bool /* simulateGravity */
+            );
+
+            /* MechanismSim overrides; see MechanismSim for documentation */
+
+            void SetInputVoltage(units::volt_t /* voltage */) override;
+            void Update(units::second_t /* dt */) override;
+            units::radian_t GetAngle() override;
+            units::radians_per_second_t GetAngularVelocity() override;
+            units::ampere_t GetCurrentDraw() override;
+            bool IsAtLowerLimit() override;
+            bool IsAtUpperLimit() override;
+
+        protected:
+            /** @brief The wpimath elevator plant */
+            frc::sim::ElevatorSim plant;
+            /** @brief Radius of the drum, used to convert height to shaft angle */
+            units::meter_t drumRadius;
+            /** @brief Lowest height of the carriage */
+            units::meter_t minHeight;
+            /** @brief Highest height of the carriage */
+            units::meter_t maxHeight;
+    }; // class ElevatorMechanism
+
+    /**
+     * @class ArmMechanism MechanismSim.h laser/MechanismSim.h
+     * @brief 
+     *      A single jointed arm, optionally against gravity.
+     * 
+     * The output shaft angle is the arm angle, measured from horizontal.
+     */
+    class ArmMechanism : public MechanismSim {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the plant parameters
+             * @param gearbox
+             *      The motors driving the arm
+             * @param gearing
+             *      The gear ratio, as used by the MotorMotion
+             * @param moi
+             *      The moment of inertia of the arm about its pivot
+             * @param armLength
+             *      The length of the arm
+             * @param minAngle
+             *      The lowest angle of the arm
+             * @param maxAngle
+             *      The highest angle of the arm
+             * @param simulateGravity
+             *      When true, gravity pulls the arm down
+             */
+            ArmMechanism(
+                const frc::DCMotor& /* gearbox */,
+                double /* gearing */,
+                units::kilogram_square_meter_t /* moi */,
+                units::meter_t /* armLength */,
+                units::radian_t /* minAngle */,
+                units::radian_t /* maxAngle */,
+                bool /* simulateGravity */
+            );
+
+            /* MechanismSim overrides; see MechanismSim for documentation */
+
+            void SetInputVoltage(units::volt_t /* voltage */) override;
+            void Update(units::second_t /* dt */) override;
+            units::radian_t GetAngle() override;
+            units::radians_per_second_t GetAngularVelocity() override;
+            units::ampere_t GetCurrentDraw() override;
+            bool IsAtLowerLimit() override;
+            bool IsAtUpperLimit() override;
+
+        protected:
+            /** @brief The wpimath arm plant */
+            frc::sim::SingleJointedArmSim plant;
+            /** @brief Lowest angle of the arm */
+            units::radian_t minAngle;
+            /** @brief Highest angle of the arm */
+            units::radian_t maxAngle;
+    }; // class ArmMechanism
+
+} // namespace simulation
+
+} // namespace laser
@@ -39,7 +39,32 @@ with MotorMotion. If not, see <https://www.gnu.org/licenses/>.
 #include <units/acceleration.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
+#include <units/time.h>
+#include <units/math.h>
+#include <frc/Timer.h>
+#include <frc/controller/ArmFeedforward.h>
+#include <frc/controller/ElevatorFeedforward.h>
+#include <frc/controller/SimpleMotorFeedforward.h>
+#include <frc/MathUtil.h>
+#include <frc/RobotController.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
+#include "laser/ConfigQueue.h"
+#include "laser/MechanismSim.h"
+#include "laser/SeqLock.h"
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -65,9 +90,219 @@ namespace laser {
         /** @brief Desired velocity in meters per second */
         eLinearVelocity,
         /** @brief Desired angular velocity in radians per second */
-        eAngularVelocity
+        eAngularVelocity,
+        /** @brief Desired position in meters, reached through an on-controller motion profile */
+        eProfiledPosition,
+        /** @brief A buffered trajectory of timed position/velocity points */
+        eTrajectory,
+        /** @brief Desired angle of the output shaft in radians */
+        eAngularPosition
     }; // enum SetpointType
 
+    /**
+     * @struct MotorState
+     * @brief 
+     *      A timestamped snapshot of the values read back from the motor 
+     *      controller during a single call to MotorMotion::Refresh()
+     * 
+     * Every getter of a MotorMotion derived class is served from this 
+     * snapshot, so reading the same motor from several places within a loop 
+     * only costs one round of vendor calls. The active setpoint is published 
+     * alongside the measurements, so a snapshot read from another thread 
+     * always pairs a setpoint with the readings taken while it was active.
+     * @see MotorMotion::Refresh()
+     * @see SeqLock
+     */
+    struct MotorState {
+        /** @brief Distance traveled in meters */
+        units::meter_t position = 0.0_m;
+        /** @brief Linear velocity of the wheel in meters per second */
+        units::meters_per_second_t velocity = 0.0_mps;
+        /** @brief Angular velocity of the output shaft in radians per second */
+        units::radians_per_second_t angularVelocity = units::radians_per_second_t(0.0);
+        /** @brief Angle of the output shaft in radians, not wrapped */
+        units::radian_t angularPosition = 0.0_rad;
+        /** @brief Motor amperage in Amperes */
+        units::ampere_t current = 0.0_A;
+        /** @brief Motor output voltage in Volts */
+        units::volt_t voltage = 0.0_V;
+        /** @brief Raw number of encoder counts that have been traveled */
+        int rawEncoderCounts = 0;
+        /** @brief Whether the forward limit switch is pressed */
+        bool isFwdLimitSwitchPressed = false;
+        /** @brief Whether the reverse limit switch is pressed */
+        bool isRevLimitSwitchPressed = false;
+        /** @brief FPGA timestamp of when the snapshot was captured */
+        units::second_t timestamp = 0.0_s;
+        /** @brief Setpoint type in use when the snapshot was published */
+        SetpointType setpointType = eNone;
+        /** @brief Last position setpoint in meters */
+        units::meter_t positionSetpoint = 0.0_m;
+        /** @brief Last linear velocity setpoint in meters per second */
+        units::meters_per_second_t velocitySetpoint = 0.0_mps;
+        /** @brief Last angular velocity setpoint in radians per second */
+        units::radians_per_second_t angularVelocitySetpoint = units::radians_per_second_t(0.0);
+        /** @brief Last angular position setpoint in radians, as commanded after wrapping */
+        units::radian_t angularPositionSetpoint = 0.0_rad;
+    }; // struct MotorState
+
+    /**
+     * @enum ConfigParam
+     * @brief 
+     *      The configuration parameters tracked by the shadow configuration 
+     *      cache of the MotorMotion class
+     */
+    enum ConfigParam {
+        /** @brief Proportional gain of a slot */
+        eConfigProportional,
+        /** @brief Integral gain of a slot */
+        eConfigIntegral,
+        /** @brief Derivative gain of a slot */
+        eConfigDerivative,
+        /** @brief Feed forward gain of a slot */
+        eConfigFeedForward,
+        /** @brief Allowable closed loop error of a slot */
+        eConfigTolerance,
+        /** @brief Integral zone of a slot */
+        eConfigIntegralZone,
+        /** @brief Closed loop ramp rate */
+        eConfigClosedRampRate,
+        /** @brief Open loop ramp rate */
+        eConfigOpenRampRate,
+        /** @brief Current limit */
+        eConfigCurrentLimit,
+        /** @brief Forward limit switch polarity */
+        eConfigFwdLimitSwitch,
+        /** @brief Reverse limit switch polarity */
+        eConfigRevLimitSwitch,
+        /** @brief Max velocity of the on-controller motion profile */
+        eConfigProfileVelocity,
+        /** @brief Max acceleration of the on-controller motion profile */
+        eConfigProfileAcceleration,
+        /** @brief S-curve strength of the on-controller motion profile */
+        eConfigProfileSCurve,
+        /** @brief Position conversion factor of an on-controller encoder */
+        eConfigPositionConversion,
+        /** @brief Velocity conversion factor of an on-controller encoder */
+        eConfigVelocityConversion,
+        /** @brief Forward soft limit threshold */
+        eConfigFwdSoftLimit,
+        /** @brief Reverse soft limit threshold */
+        eConfigRevSoftLimit,
+        /** @brief Period of a status frame; the slot is the frame */
+        eConfigStatusFramePeriod,
+        /** @brief Whether the reverse limit switch clears the sensor position */
+        eConfigClearPositionOnRevLimit
+    }; // enum ConfigParam
+
+    /**
+     * @enum Signal
+     * @brief 
+     *      Groups of signals a mechanism can read from its motor controller; 
+     *      combined as a bitmask and passed to 
+     *      MotorMotion::SetConsumedSignals()
+     */
+    enum Signal {
+        /** @brief No signals; every status frame is slowed down */
+        eSignalNone = 0,
+        /** @brief Sensor position */
+        eSignalPosition = 1 << 0,
+        /** @brief Sensor velocity */
+        eSignalVelocity = 1 << 1,
+        /** @brief Motor current */
+        eSignalCurrent = 1 << 2,
+        /** @brief Limit switch states */
+        eSignalLimitSwitches = 1 << 3,
+        /** @brief Fault flags */
+        eSignalFaults = 1 << 4,
+        /**
+         * @brief 
+         *      Applied output, read as the motor voltage; followers track the 
+         *      leader through the frame carrying it
+         */
+        eSignalAppliedOutput = 1 << 5,
+        /** @brief Every signal; the status frames run at their default rates */
+        eSignalAll = eSignalPosition | eSignalVelocity | eSignalCurrent | eSignalLimitSwitches | eSignalFaults | eSignalAppliedOutput
+    }; // enum Signal
+
+    /**
+     * @enum MotionEvent
+     * @brief 
+     *      Transitions of the motor state that listeners can be registered 
+     *      for through MotorMotion::AddListener(); each fires once, on the 
+     *      refresh where the transition is seen
+     */
+    enum MotionEvent {
+        /** @brief The forward limit switch went from released to pressed */
+        eFwdLimitSwitchPressed,
+        /** @brief The forward limit switch went from pressed to released */
+        eFwdLimitSwitchReleased,
+        /** @brief The reverse limit switch went from released to pressed */
+        eRevLimitSwitchPressed,
+        /** @brief The reverse limit switch went from pressed to released */
+        eRevLimitSwitchReleased,
+        /** @brief The motor came within tolerance of its setpoint */
+        eSetpointReached,
+        /** @brief The motor left the tolerance of its setpoint */
+        eSetpointLeft,
+        /** @brief The position rose to or past a threshold */
+        ePositionRoseAbove,
+        /** @brief The position fell below a threshold */
+        ePositionFellBelow,
+        /** @brief The velocity rose to or past a threshold */
+        eVelocityRoseAbove,
+        /** @brief The velocity fell below a threshold */
+        eVelocityFellBelow
+    }; // enum MotionEvent
+
+    /**
+     * @struct ConfigStats
+     * @brief 
+     *      Counters of the configuration writes that reached the motor 
+     *      controller versus the ones skipped by the shadow configuration 
+     *      cache
+     */
+    struct ConfigStats {
+        /** @brief Number of configuration writes sent to the motor controller */
+        unsigned long issued = 0;
+        /** @brief Number of configuration writes skipped because the value was unchanged */
+        unsigned long suppressed = 0;
+        /** @brief Number of issued configuration writes that reported an error */
+        unsigned long failed = 0;
+    }; // struct ConfigStats
+
+    /**
+     * @struct TrajectoryPoint
+     * @brief 
+     *      A single timed point of a trajectory streamed to the motor 
+     *      controller through MotorMotion::StartTrajectory()
+     */
+    struct TrajectoryPoint {
+        /** @brief Time of the point, measured from the start of the trajectory */
+        units::second_t time = 0.0_s;
+        /** @brief Desired position in meters */
+        units::meter_t position = 0.0_m;
+        /** @brief Desired linear velocity in meters per second */
+        units::meters_per_second_t velocity = 0.0_mps;
+    }; // struct TrajectoryPoint
+
+    /**
+     * @struct TrajectoryProgress
+     * @brief 
+     *      The progress of the trajectory started through 
+     *      MotorMotion::StartTrajectory()
+     */
+    struct TrajectoryProgress {
+        /** @brief Number of points streamed to the motor controller */
+        int totalPoints = 0;
+        /** @brief Number of points buffered on the motor controller that have yet to run */
+        int bufferedPoints = 0;
+        /** @brief Whether the motor controller ran out of buffered points before the end */
+        bool hasUnderrun = false;
+        /** @brief Whether the last point of the trajectory has been reached */
+        bool isFinished = false;
+    }; // struct TrajectoryProgress
+
     /**
      * @class MotorMotion MotorMotion.h laser/MotorMotion.h
      * @brief 
@@ -79,9 +314,8 @@ namespace laser {
      * methods that are meant to be implemented by other classes for the 
      * expressed purpose of knowing what methods it must have.
      * @warning 
-     *      This class cannot be instantiated, otherwise your code may throw a 
-     *      segmentation fault due to null pointers. Please use TalonFXMotion or
-     *      SparkMaxMotion for this purpose.
+     *      This class cannot be instantiated, as its virtual methods are pure.
+     *      Please use TalonFXMotion or SparkMaxMotion for this purpose.
      * @see MotorMotion.h
      * @see TalonFXMotion
      * @see SparkMaxMotion
@@ -89,6 +323,13 @@ namespace laser {
     template <typename ErrorEnum, class MotorType>
     class MotorMotion {
         public:
+            /**
+             * @brief 
+             *      Destructor for the class; virtual so derived classes can be
+             *      deleted through a MotorMotion pointer
+             */
+            virtual ~MotorMotion() = default;
+
             /* Virtual methods that tend to depend on MotorType */
 
             /**
@@ -101,7 +342,7 @@ namespace laser {
              *      When true, the Reverse Limit Switch will be treated as 
              *      Normally Open
              */
-            virtual void ConfigLimitSwitches(bool /* isFwdNO */, bool /* isRevNO */);
+            virtual void ConfigLimitSwitches(bool /* isFwdNO */, bool /* isRevNO */) = 0;
 
             /**
              * @brief 
@@ -112,13 +353,13 @@ namespace laser {
              *      The error reported by the motor controller, based on the 
              *      derived class's inheritance template
              */
-            virtual ErrorEnum ConfigCurrentLimit(units::ampere_t /* amps */);
+            virtual ErrorEnum ConfigCurrentLimit(units::ampere_t /* amps */) = 0;
 
             /**
              * @brief 
              *      Halts the motor as quickly as the open-loop ramp rate allows
              */
-            virtual void Stop();
+            virtual void Stop() = 0;
 
             /**
              * @brief 
@@ -127,7 +368,7 @@ namespace laser {
              * @return 
              *      units::meter_t representing the distance traveled in meters
              */
-            virtual units::meter_t GetActualPosition();
+            virtual units::meter_t GetActualPosition() = 0;
 
             /**
              * @brief 
@@ -136,7 +377,7 @@ namespace laser {
              * @return 
              *      units::meters_per_second_t representing the velocity in m/s
              */
-            virtual units::meters_per_second_t GetActualVelocity();
+            virtual units::meters_per_second_t GetActualVelocity() = 0;
 
             /**
              * @brief 
@@ -147,7 +388,7 @@ namespace laser {
              *      units::radians_per_second_t representing the angular 
              *      velocity in rad/s
              */
-            virtual units::radians_per_second_t GetActualAngularVelocity();
+            virtual units::radians_per_second_t GetActualAngularVelocity() = 0;
 
             /**
              * @brief 
@@ -156,7 +397,7 @@ namespace laser {
              *      The max tolerance of the position; how far off the actual
              *      is liable to be from the setpoint
              */
-            virtual units::meter_t GetPositionTolerance();
+            virtual units::meter_t GetPositionTolerance() = 0;
 
             /**
              * @brief 
@@ -165,7 +406,7 @@ namespace laser {
              *      The max tolerance of the velocity; how far off the actual 
              *      is liable to be from the setpoint
              */
-            virtual units::meters_per_second_t GetVelocityTolerance();
+            virtual units::meters_per_second_t GetVelocityTolerance() = 0;
 
             /**
              * @brief 
@@ -174,7 +415,16 @@ namespace laser {
              *      The max tolerance of the velocity; how far off the actual 
              *      is liable to be from the setpoint
              */
-            virtual units::radians_per_second_t GetAngularVelocityTolerance();
+            virtual units::radians_per_second_t GetAngularVelocityTolerance() = 0;
+
+            /**
+             * @brief 
+             *      Returns the tolerance of the angular position in radians
+             * @return 
+             *      The max tolerance of the angle; how far off the actual is 
+             *      liable to be from the setpoint
+             */
+            virtual units::radian_t GetAngularPositionTolerance() = 0;
 
             /**
              * @brief 
@@ -183,7 +433,7 @@ namespace laser {
              * @param isInverted
              *      When true, the motor is to be inverted
              */
-            virtual void SetMotorInverted(bool /* isInverted */);
+            virtual void SetMotorInverted(bool /* isInverted */) = 0;
 
             /**
              * @brief 
@@ -204,7 +454,30 @@ namespace laser {
                 double /* integral */, 
                 double /* derivative */, 
                 double /* feedforward */
-            );
+            ) = 0;
+
+            /**
+             * @brief 
+             *      Sets the PIDF values for a specific setpoint type, 
+             *      regardless of which setpoint type is currently active
+             * @param type
+             *      The setpoint type whose PID values should be set
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            virtual void SetPIDValues(
+                SetpointType /* type */,
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            ) = 0;
 
             /**
              * @brief 
@@ -212,7 +485,7 @@ namespace laser {
              * @param tolerance
              *      The maximum tolerance in units::meter_t
              */
-            virtual void SetTolerance(units::meter_t /* tolerance */);
+            virtual void SetTolerance(units::meter_t /* tolerance */) = 0;
 
             /**
              * @brief 
@@ -220,7 +493,7 @@ namespace laser {
              * @param tolerance
              *      The maximum tolerance in units::meters_per_second_t
              */
-            virtual void SetTolerance(units::meters_per_second_t /* tolerance */);
+            virtual void SetTolerance(units::meters_per_second_t /* tolerance */) = 0;
 
             /**
              * @brief 
@@ -228,7 +501,16 @@ namespace laser {
              * @param tolerance
              *      The maximum tolerance in units::radians_per_second_t
              */
-            virtual void SetTolerance(units::radians_per_second_t /* tolerance */);
+            virtual void SetTolerance(units::radians_per_second_t /* tolerance */) = 0;
+
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the angular position 
+             *      setpoint
+             * @param tolerance
+             *      The maximum tolerance in units::radian_t
+             */
+            virtual void SetTolerance(units::radian_t /* tolerance */) = 0;
 
             /**
              * @brief 
@@ -236,7 +518,7 @@ namespace laser {
              * @return 
              *      units::volt_t representing the motor voltage in Volts
              */
-            virtual units::volt_t GetMotorVoltage();
+            virtual units::volt_t GetMotorVoltage() = 0;
 
             /**
              * @brief 
@@ -244,7 +526,7 @@ namespace laser {
              * @param voltage
              *      units::volt_t representing the motor voltage in Volts
              */
-            virtual void SetMotorVoltage(units::volt_t /* voltage */);
+            virtual void SetMotorVoltage(units::volt_t /* voltage */) = 0;
 
             /**
              * @brief 
@@ -252,7 +534,7 @@ namespace laser {
              * @return
              *      units::ampere_t representing the motor amperage in Amperes
              */
-            virtual units::ampere_t GetMotorCurrent();
+            virtual units::ampere_t GetMotorCurrent() = 0;
 
             /**
              * @brief 
@@ -261,7 +543,7 @@ namespace laser {
              * @return 
              *      Integer value representing the number of encoder counts
              */
-            virtual int GetRawEncoderCounts();
+            virtual int GetRawEncoderCounts() = 0;
 
             /**
              * @brief 
@@ -272,7 +554,7 @@ namespace laser {
              *      Time in units::second_t of the fastest time the closed loop
              *      controller is allowed
              */
-            virtual void SetClosedRampRate(units::second_t /* time */);
+            virtual void SetClosedRampRate(units::second_t /* time */) = 0;
 
             /**
              * @brief 
@@ -283,7 +565,7 @@ namespace laser {
              *      Time in units::second_t of the fastest time the open loop 
              *      controller is allowed
              */
-            virtual void SetOpenRampRate(units::second_t /* time */);
+            virtual void SetOpenRampRate(units::second_t /* time */) = 0;
 
             /**
              * @brief 
@@ -291,7 +573,7 @@ namespace laser {
              * @param position
              *      Desired position of the motor in units::meter_t
              */
-            virtual void SetSetpoint(units::meter_t /* position */);
+            virtual void SetSetpoint(units::meter_t /* position */) = 0;
 
             /**
              * @brief 
@@ -301,7 +583,7 @@ namespace laser {
              *      Desired linear velocity of the motor in 
              *      units::meters_per_second_t
              */
-            virtual void SetSetpoint(units::meters_per_second_t /* lvelocity */);
+            virtual void SetSetpoint(units::meters_per_second_t /* lvelocity */) = 0;
 
             /**
              * @brief 
@@ -311,352 +593,1994 @@ namespace laser {
              *      Desired angular velocity of the motor in 
              *      units::radians_per_second_t
              */
-            virtual void SetSetpoint(units::radians_per_second_t /* avelocity */);
+            virtual void SetSetpoint(units::radians_per_second_t /* avelocity */) = 0;
 
             /**
              * @brief 
-             *      Sets the Integral Zone for error in units per millisecond;
-             *      this is in revolutions of the output shaft only
-             * @param _ISzone
-             *      Desired IZone left as a primitive double
+             *      Sets the setpoint for the angle of the output shaft in 
+             *      radians; with continuous input, the shortest rotation to an
+             *      equivalent angle is taken
+             * @param angle
+             *      Desired angle of the output shaft in units::radian_t
+             * @see SetContinuousInput()
              */
-            virtual void SetAccumIZone(double /* _izone */);
+            virtual void SetSetpoint(units::radian_t /* angle */) = 0;
 
             /**
              * @brief 
-             *      Sets the positional soft limits in meters; the motor will 
-             *      not intentionally leave the interval of values, [minpos, 
-             *      maxpos] 
-             * @param minpos
-             *      Minimum position value in units::meter_t, must be less
-             *      than maxpos
-             * @param maxpos
-             *      Maximum position values in units::meter_t, must be greater
-             *      than minpos
+             *      Sets the constraints of the on-controller motion profile 
+             *      used by profiled position setpoints
+             * @param maxVelocity
+             *      The cruise velocity of the profile in 
+             *      units::meters_per_second_t
+             * @param maxAcceleration
+             *      The acceleration of the profile in 
+             *      units::meters_per_second_squared_t
+             * @param sCurveStrength
+             *      How much the acceleration is smoothed, from 0 (trapezoidal)
+             *      to 8 (smoothest)
              */
-            virtual void SetPositionSoftLimits(units::meter_t /* minpos */, units::meter_t /* maxpos */);
+            virtual void SetMotionConstraints(
+                units::meters_per_second_t /* maxVelocity */, 
+                units::meters_per_second_squared_t /* maxAcceleration */, 
+                int /* sCurveStrength */
+            ) = 0;
 
             /**
              * @brief 
-             *      Returns the state of the reverse limit switch
-             * @return 
-             *      Boolean value, true = pressed, false = unpressed
+             *      Sets a position setpoint in meters that the motor 
+             *      controller reaches by following a motion profile within the 
+             *      configured motion constraints
+             * @param position
+             *      Desired position of the motor in units::meter_t
              */
-            virtual bool IsRevLimitSwitchPressed();
+            virtual void SetProfiledSetpoint(units::meter_t /* position */) = 0;
 
             /**
              * @brief 
-             *      Returns the state of the forward limit switch
+             *      Streams a trajectory to the motor controller's buffer in 
+             *      the background and starts executing it; the controller 
+             *      runs the points at its native rate
+             * @param points
+             *      The timed points of the trajectory, in order
              * @return 
-             *      Boolean value, true = pressed, false = unpressed
+             *      The error reported by the motor controller, based on the 
+             *      derived class's inheritance template
              */
-            virtual bool IsFwdLimitSwitchPressed();
+            virtual ErrorEnum StartTrajectory(std::span<const TrajectoryPoint> /* points */) = 0;
 
             /**
              * @brief 
-             *      Stops the motor and resets the encoder to 0
+             *      Returns the progress of the trajectory started through 
+             *      StartTrajectory()
+             * @return 
+             *      The buffer and completion state of the trajectory
              */
-            virtual void Reset();
-
-            /* One liners - non-virtual */
+            virtual TrajectoryProgress GetTrajectoryProgress() = 0;
 
             /**
              * @brief 
-             *      Returns the pointer to the MotorType class for specific use
-             *      cases
-             * @return 
-             *      Pointer to class MotorType
+             *      Sets the Integral Zone for error in units per millisecond;
+             *      this is in revolutions of the output shaft only
+             * @param _ISzone
+             *      Desired IZone left as a primitive double
              */
-            MotorType* GetMotorPointer() { return motor; }
+            virtual void SetAccumIZone(double /* _izone */) = 0;
 
             /**
              * @brief 
-             *      Sets the motor output percentage
-             * @param percent
-             *      A percentage from [-1, 1]; exceeding this interval may
-             *      cause undefined behavior
+             *      Sets the positional soft limits in meters; the motor will 
+             *      not intentionally leave the interval of values, [minpos, 
+             *      maxpos]. The limits are enforced by the motor controller
+             *      itself; passing equal values disables them, and limits 
+             *      given in the wrong order are swapped
+             * @param minpos
+             *      Minimum position value in units::meter_t
+             * @param maxpos
+             *      Maximum position values in units::meter_t
              */
-            void Set(double percent) { motor->Set(percent); }
+            virtual void SetPositionSoftLimits(units::meter_t /* minpos */, units::meter_t /* maxpos */) = 0;
 
             /**
              * @brief 
-             *      Returns the setpoint type currently in use; this is 
-             *      determined by previously called methods
+             *      Makes the motor controller zero its sensor position on its
+             *      own as soon as the reverse limit switch closes, without 
+             *      waiting for the roboRIO to see the switch
+             * @param isEnabled
+             *      When true, closing the reverse limit switch clears the 
+             *      position
              * @return 
-             *      The setpoint type currently in use; see the SetpointType 
-             *      enum for what these types are
+             *      The error reported by the motor controller, or a not 
+             *      implemented error when it can't do this
+             * @see commands::eHomeReverseTwoPhase
              */
-            SetpointType GetSetpointType() { return setpointType; }
+            virtual ErrorEnum SetClearPositionOnRevLimit(bool /* isEnabled */) = 0;
 
             /**
              * @brief 
-             *      Returns the current position setpoint; use 
-             *      GetSetpointType() to check if this is the active setpoint
+             *      Returns the state of the reverse limit switch
              * @return 
-             *      The distance of the position setpoint in units::meter_t
+             *      Boolean value, true = pressed, false = unpressed
              */
-            units::meter_t GetPositionSetpoint() { return positionSetpoint; }
+            virtual bool IsRevLimitSwitchPressed() = 0;
 
             /**
              * @brief 
-             *      Returns th current linear velocity setpoint; use 
-             *      GetSetpointType() to check if this is the active setpoint
+             *      Returns the state of the forward limit switch
              * @return 
-             *      The velocity of the linear velocity setpoint in 
-             *      units::meters_per_secont_t
+             *      Boolean value, true = pressed, false = unpressed
              */
-            units::meters_per_second_t GetVelocitySetpoint() { return velocitySetpoint; }
+            virtual bool IsFwdLimitSwitchPressed() = 0;
 
             /**
              * @brief 
-             *      Returns the angular velocity setpoint; use 
-             *      GetSetpointType() to check if this is the active setpoint
-             * @return 
-             *      The angular velocity of the angular velocity setpoint in 
-             *      units::radians_per_second_t
+             *      Stops the motor and resets the encoder to 0, or seeds it 
+             *      from the absolute sensor when one is attached and has a 
+             *      valid reading
+             * @see SetAbsoluteSensor()
+             * @see IsAbsoluteSeedValid()
              */
-            units::radians_per_second_t GetAngularVelocitySetpoint() { return avelSetpoint; }
+            virtual void Reset() = 0;
 
             /**
              * @brief 
-             *      Returns the last recorded error, if any
-             * @return 
-             *      Type based on template of the class; the last error known 
-             *      to have occurred
+             *      Reads every signal from the motor controller once and 
+             *      stores it, along with a capture timestamp, in the cached 
+             *      MotorState; the getters serve this cached state, and the 
+             *      registered event listeners are evaluated against it
+             * 
+             * Implementations hold the refresh mutex while reading and 
+             * publishing, so calls from several threads, including the lazy
+             * refresh of a stale getter, run one at a time; the callbacks of 
+             * fired events run after it is released.
+             * @see AddListener()
              */
-            ErrorEnum GetLastError() { return lastError; }
+            virtual void Refresh() = 0;
 
             /**
              * @brief 
-             *      Sets the gear ratio to be used for calculations between 
-             *      unit conversions of the wheel and actual motor rotation
-             * @param ratio
-             *      The desired gear ratio as a decimal value (output to input)
+             *      Recomputes the unit conversion factors from the gear ratio 
+             *      and wheel diameter, then re-applies every configured value
+             *      that depends on them
              */
-            void SetGearing(double ratio) { gearing = ratio; }
+            virtual void UpdateConversionFactors() = 0;
 
             /**
              * @brief 
-             *      Returns the configured gear ratio as a decimal value
-             * @return 
-             *      The gear ratio currently being used to determine how motor 
-             *      rotation correlates to distance and velocity
+             *      Advances the attached mechanism by one time step using the 
+             *      simulated motor voltage, then writes the resulting sensor 
+             *      values back into the simulated motor controller; does 
+             *      nothing if no mechanism is attached
+             * 
+             * A plant driven motor uses the voltage commanded on the roboRIO
+             * instead, and leaves the simulated motor controller alone.
+             * @see SetPlantDriven()
+             * @param dt
+             *      The length of the time step in units::second_t
              */
-            double GetGearing() { return gearing; }
+            virtual void SimulationPeriodic(units::second_t /* dt */) = 0;
 
             /**
              * @brief 
-             *      Sets the desired wheel diameter, in meters, to be used for 
-             *      calculating distances and velocities
-             * @param diameter
-             *      Desired wheel diameter in units::meter_t
+             *      Puts the motor controller in follower mode, mirroring the 
+             *      output of another motor controller of the same type
+             * @param leader
+             *      The MotorMotion object to follow
+             * @param isOpposed
+             *      When true, the output is reversed relative to the leader
+             * @return 
+             *      The error reported by the motor controller, or an invalid 
+             *      parameter error without changing anything when the leader 
+             *      is this motor
+             * @see MotorMotionGroup
              */
-            void SetWheelDiameter(units::meter_t diameter) { wheelDiameter = diameter; }
+            virtual ErrorEnum Follow(MotorMotion& /* leader */, bool /* isOpposed */) = 0;
 
-            units::meter_t GetWheelDiameter() { return wheelDiameter; }
+            /* One liners - non-virtual */
 
-        protected:
             /**
              * @brief 
-             *      Pointer to class MotorType, based on template of the class
+             *      Declares which signals this mechanism actually reads; the 
+             *      status frames carrying them run at their default rates, 
+             *      and every other status frame is slowed down to save CAN 
+             *      bandwidth
+             * 
+             * Leave eSignalAppliedOutput in the mask on any motor that reads 
+             * its voltage or that other motors follow; adaptive frame rates 
+             * never slow it down.
+             * @param signals
+             *      A bitmask of Signal values, e.g. 
+             *      eSignalPosition | eSignalVelocity | eSignalAppliedOutput
+             * @return 
+             *      The first error reported while setting the frame periods
+             */
+            ErrorEnum SetConsumedSignals(int signals) {
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                consumedSignals = signals;
+                return ApplySignalFrames(GetActiveSignals());
+            }
+
+            /**
+             * @brief 
+             *      Enables or disables adaptive status frame rates; when 
+             *      enabled, the feedback frames (position, velocity and 
+             *      current) are slowed down while the mechanism is idle
+             * 
+             * The mechanism is idle once it has been stopped through Stop(),
+             * or has been at its setpoint (see IsAtSetpoint()), while moving
+             * no faster than the idle velocity for the whole idle delay. Any
+             * new setpoint or output, or any movement, brings the frames back
+             * to their full rate on the spot.
+             * @param isEnabled
+             *      When true, frame rates follow the motion state
+             * @param idleVelocity
+             *      The fastest the mechanism can move while idle, in 
+             *      units::meters_per_second_t (default 0.01 m/s)
+             * @param idleDelay
+             *      How long the mechanism must stay idle before its frames 
+             *      are slowed down, in units::second_t (default 0.25 s)
+             */
+            void SetAdaptiveFrameRates(bool isEnabled, units::meters_per_second_t idleVelocity = 0.01_mps, units::second_t idleDelay = 0.25_s) {
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                isAdaptiveFrameRate = isEnabled;
+                adaptiveIdleVelocity = idleVelocity;
+                adaptiveIdleDelay = idleDelay;
+                idleSince = -1.0_s;
+
+                if (isFrameRateIdle) {
+                    isFrameRateIdle = false;
+                    ApplySignalFrames(GetActiveSignals());
+                }
+            }
+
+            /**
+             * @brief 
+             *      Returns whether the feedback frames are currently slowed 
+             *      down because the mechanism is idle
+             * @return 
+             *      True while adaptive frame rates consider the mechanism idle
              */
-            MotorType* motor;
+            bool IsFrameRateIdle() {
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                return isFrameRateIdle;
+            }
 
             /**
              * @brief 
-             *      Last error to have known to occurred
+             *      Returns whether the motor was stopped through Stop() and 
+             *      hasn't been given a setpoint or output since
+             * @return 
+             *      True while the motor is stopped
              */
-            ErrorEnum lastError;
+            bool IsStopped() { return isStopped; }
 
             /**
              * @brief 
-             *      SetpointType enum type recording the currently in-use 
-             *      setpoint
+             *      Returns whether the latest state is within the tolerance of
+             *      the active setpoint
+             * @return 
+             *      True if the active setpoint is a position or velocity and 
+             *      the error is within its tolerance; false otherwise
              */
-            SetpointType setpointType;
-
-            /* Primitive member types */
+            bool IsAtSetpoint() { return IsAtSetpoint(Snapshot()); }
 
             /**
              * @brief 
-             *      Is forward limit switch Normally Open?
+             *      Registers a callback for a limit switch or setpoint event; 
+             *      events are evaluated once per Refresh() from the refreshed
+             *      state, so listeners never touch the bus themselves
+             * 
+             * Callbacks run on the thread calling Refresh() (the scheduler 
+             * thread, when there is one), after every lock has been released,
+             * so they may call back into this object.
+             * @param event
+             *      One of the limit switch or setpoint MotionEvent values
+             * @param callback
+             *      Callable invoked every time the event fires
+             * @return 
+             *      An id that can be passed to RemoveListener()
              */
-            bool isFwdLimitSwitchNO;
+            int AddListener(MotionEvent event, std::function<void()> callback) {
+                return AddEventListener(event, 0.0, std::move(callback));
+            }
 
             /**
              * @brief 
-             *      Is reverse limit switch Normally Open?
+             *      Registers a callback for a position threshold crossing
+             * @param event
+             *      ePositionRoseAbove or ePositionFellBelow
+             * @param threshold
+             *      The position to watch in units::meter_t
+             * @param callback
+             *      Callable invoked every time the position crosses the 
+             *      threshold in the direction of the event
+             * @return 
+             *      An id that can be passed to RemoveListener()
              */
-            bool isRevLimitSwitchNO;
+            int AddListener(MotionEvent event, units::meter_t threshold, std::function<void()> callback) {
+                return AddEventListener(event, (double)threshold, std::move(callback));
+            }
 
             /**
              * @brief 
-             *      Current position setpoint in units::meter_t; this describes
-             *      how far the wheel should travel compared to its position 
-             *      when first initializing
+             *      Registers a callback for a linear velocity threshold 
+             *      crossing; the velocity is signed, so a speed threshold in 
+             *      both directions needs a listener on each side of zero
+             * @param event
+             *      eVelocityRoseAbove or eVelocityFellBelow
+             * @param threshold
+             *      The velocity to watch in units::meters_per_second_t
+             * @param callback
+             *      Callable invoked every time the velocity crosses the 
+             *      threshold in the direction of the event
+             * @return 
+             *      An id that can be passed to RemoveListener()
              */
-            units::meter_t positionSetpoint;
+            int AddListener(MotionEvent event, units::meters_per_second_t threshold, std::function<void()> callback) {
+                return AddEventListener(event, (double)threshold, std::move(callback));
+            }
 
             /**
              * @brief 
-             *      Current linear velocity setpoint in 
-             *      units::meters_per_second_t; this describes how fast the 
-             *      wheel should move
+             *      Registers a flag that is raised every time an event fires;
+             *      the consumer clears it, e.g. with flag->exchange(false), 
+             *      when it handles the event
+             * @param event
+             *      One of the limit switch or setpoint MotionEvent values
+             * @return 
+             *      The flag, shared with the listener raising it
              */
-            units::meters_per_second_t velocitySetpoint;
+            std::shared_ptr<std::atomic<bool>> AddFlag(MotionEvent event) {
+                auto flag = std::make_shared<std::atomic<bool>>(false);
+                AddListener(event, [flag] { *flag = true; });
+                return flag;
+            }
 
             /**
              * @brief 
-             *      Current angular velocity setpoint in 
-             *      units::radians_per_second_t; this describes how fast the 
-             *      output shaft should spin (2pi rad/s = 1/60 rpm)
+             *      Unregisters a listener; a callback that is already running
+             *      finishes normally
+             * @param id
+             *      The id returned when the listener was added
              */
-            units::radians_per_second_t avelSetpoint;
+            void RemoveListener(int id) {
+                std::lock_guard<std::mutex> lock(eventMutex);
+                std::erase_if(listeners, [id](const EventListener& listener) { return listener.id == id; });
+            }
 
             /**
              * @brief 
-             *      Proportional gain for the closed feedback controller for 
-             *      position
+             *      Returns the signals declared through SetConsumedSignals()
+             * @return 
+             *      A bitmask of Signal values (default eSignalAll)
              */
-            double positionProportional;
+            int GetConsumedSignals() { return consumedSignals; }
 
             /**
              * @brief 
-             *      Integral gain for the closed feedback controller for
-             *      position
+             *      Keeps the status frames carrying a set of signals at their
+             *      default rates, whatever is later passed to 
+             *      SetConsumedSignals() and whether or not the mechanism is 
+             *      idle; e.g. the applied output of a leader that other 
+             *      motors follow
+             * @param signals
+             *      A bitmask of Signal values to add to the pinned signals
+             * @return 
+             *      The first error reported while setting the frame periods
              */
-            double positionIntegral;
-            
+            ErrorEnum PinSignals(int signals) {
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                pinnedSignals |= signals;
+                return ApplySignalFrames(GetActiveSignals());
+            }
+
             /**
              * @brief 
-             *      Derivative gain for the closed feedback controller for 
-             *      position
+             *      Returns how many status frames per second this motor 
+             *      controller sends with its current frame periods
+             * @return 
+             *      The number of status frames per second
+             * @see CANBusBudget
              */
-            double positionDerivative;
+            double GetStatusFrameRate() {
+                std::lock_guard<std::mutex> lock(configMutex);
+
+                double framesPerSecond = 0.0;
+                for (auto& [frame, period] : statusFramePeriods) {
+                    framesPerSecond += 1.0 / (double)units::second_t(period);
+                }
+                return framesPerSecond;
+            }
 
             /**
              * @brief 
-             *      Feed forward gain for the closed feedback controller for 
-             *      position
+             *      Attaches the physics model of the mechanism this motor 
+             *      drives; it is stepped by SimulationPeriodic()
+             * @param sim
+             *      The mechanism model, e.g. a simulation::FlywheelMechanism
              */
-            double positionFeedForward;
+            void AttachSimulation(std::unique_ptr<simulation::MechanismSim> sim) { mechanism = std::move(sim); }
 
             /**
              * @brief 
-             *      Maximum allowed error of the setpoint; this should be as 
-             *      small as your PID values are accurate
+             *      Returns the attached mechanism model
+             * @return 
+             *      The MechanismSim pointer, or nullptr if none is attached
              */
-            units::meter_t positionTolerance;
+            simulation::MechanismSim* GetSimulation() { return mechanism.get(); }
 
             /**
              * @brief 
-             *      Proportional gain for the closed feedback controller for 
-             *      linear velocity
+             *      Drives the attached mechanism from the output commanded on
+             *      the roboRIO and reads the state straight back from it, 
+             *      bypassing the simulated motor controller
+             * 
+             * The vendors' simulated firmware runs on its own wall-clock 
+             * thread, so runs through it never repeat exactly and can't be 
+             * stepped faster than real time; a plant driven motor doesn't 
+             * touch it. Open loop outputs (Set(), SetMotorVoltage() and 
+             * Stop()) reach the mechanism as commanded. Closed loop setpoints
+             * and following run on the motor controller, so they leave the 
+             * mechanism unpowered; close the loop on the roboRIO instead, 
+             * e.g. with a SimulationHarness control loop. The limit switches
+             * read as pressed while the mechanism sits at either end of its
+             * travel.
+             * @param isEnabled
+             *      When true, the attached mechanism is driven from the roboRIO
+             * @see SimulationHarness
              */
-            double velocityProportional;
+            void SetPlantDriven(bool isEnabled) {
+                isPlantDriven = isEnabled;
+                InvalidateState();
+            }
 
             /**
              * @brief 
-             *      Integral gain for the closed feedback controller for 
-             *      linear velocity
+             *      Returns whether the attached mechanism is driven from the 
+             *      roboRIO
+             * @return 
+             *      True if SetPlantDriven() enabled it and a mechanism is 
+             *      attached
              */
-            double velocityIntegral;
+            bool IsPlantDriven() { return isPlantDriven && mechanism; }
 
             /**
              * @brief 
-             *      Derivative gain for the closed feedback controller for 
-             *      linear velocity
+             *      Marks the published state as stale so the next getter 
+             *      refreshes it, e.g. after the encoder is reset, or after the
+             *      motor controller zeroes it on its own at a limit switch
              */
-            double velocityDerivative;
+            void InvalidateState() {
+                std::lock_guard<std::mutex> lock(publishMutex);
+
+                state.timestamp = 0.0_s;
+                published.Store(state);
+            }
 
             /**
              * @brief 
-             *      Feed forward gain for the closed feedback controller for 
-             *      linear velocity
+             *      Returns the most recent MotorState snapshot, refreshing it
+             *      first if it is older than the max state age; this is safe
+             *      to call from any thread, but a stale read waits for any 
+             *      refresh already running
+             * @return 
+             *      The cached MotorState
              */
-            double velocityFeedForward;
+            MotorState GetState() { return Snapshot(); }
 
             /**
              * @brief 
-             *      Maximum allowed error of the setpoint; this should be as 
-             *      small as your PID values are accurate
+             *      Sets how old the cached MotorState is allowed to get before
+             *      a getter refreshes it on its own; when set to zero, the 
+             *      state is only updated through Refresh()
+             * @param age
+             *      The max age of the cached state in units::second_t
              */
-            units::meters_per_second_t velocityTolerance;
+            void SetStateMaxAge(units::second_t age) { stateMaxAge = age; }
 
             /**
              * @brief 
-             *      Proportional gain of the closed feedback controller for 
-             *      angular velocity
+             *      Returns how old the cached MotorState is allowed to get 
+             *      before a getter refreshes it on its own
+             * @return 
+             *      The max age of the cached state in units::second_t
              */
-            double avelProportional;
+            units::second_t GetStateMaxAge() { return stateMaxAge; }
 
             /**
              * @brief 
-             *      Integral gain for the closed feedback controller for 
-             *      angular velocity
+             *      Returns how many configuration writes were sent to the 
+             *      motor controller and how many were skipped because the 
+             *      value had not changed
+             * @return 
+             *      The ConfigStats counters of this motor
              */
-            double avelIntegral;
+            ConfigStats GetConfigStats() {
+                std::lock_guard<std::mutex> lock(configMutex);
+                return configStats;
+            }
 
             /**
              * @brief 
-             *      Derivative gain for the closed feedback controller for 
-             *      angular velocity
+             *      Forgets every value in the shadow configuration cache, so 
+             *      the next write of each parameter reaches the motor 
+             *      controller; use this after configuring the motor directly
+             *      through GetMotorPointer()
              */
-            double avelDerivative;
+            void InvalidateConfigCache() {
+                std::lock_guard<std::mutex> lock(configMutex);
+                configShadow.clear();
+            }
 
             /**
              * @brief 
-             *      Feed forward gain for the closed feedback controller for 
-             *      angular velocity
+             *      Enables or disables async configuration mode; when enabled,
+             *      configuration writes are queued for a background worker 
+             *      thread instead of running on the calling thread
+             * 
+             * In async mode, errors are reported through GetLastError() once
+             * the write has run, since the configuring method returns before
+             * the motor controller has answered.
+             * @param enabled
+             *      When true, configuration writes are run asynchronously
+             * @param timeout
+             *      How long the worker thread waits for the motor controller 
+             *      to acknowledge each write, in units::second_t
+             * @see ConfigQueue
              */
-            double avelFeedForward;
+            void SetAsyncConfig(bool enabled, units::second_t timeout = 0.1_s) {
+                isAsyncConfig = enabled;
+                asyncConfigTimeout = timeout;
+            }
 
             /**
              * @brief 
-             *      Maximum allowed error of the setpoint; this should be as 
-             *      small as your PID values are accurate
+             *      Returns whether async configuration mode is enabled
+             * @return 
+             *      True when configuration writes run on the background thread
              */
-            units::radians_per_second_t avelTolerance;
+            bool IsAsyncConfig() { return isAsyncConfig; }
 
             /**
              * @brief 
-             *      Farthest back the motor is allowed to travel; when set to 
-             *      zero, this is ignored
+             *      Returns whether any queued configuration write of this 
+             *      motor has yet to run
+             * @return 
+             *      True while async configuration writes are outstanding
              */
-            units::meter_t lowerPositionSoftLimit;
+            bool IsConfigPending() {
+                PrunePendingConfigs();
+                return !pendingConfigs.empty();
+            }
 
             /**
              * @brief 
-             *      Farthest forward the motor is allowed to travel; when set 
-             *      to zero, this is ignored
+             *      Blocks until every queued configuration write of this motor
+             *      has run; this should not be called from the robot loop
+             * @return 
+             *      The last error reported by a configuration write
              */
-            units::meter_t upperPositionSoftLimit;
+            ErrorEnum WaitForConfig() {
+                for (auto& pending : pendingConfigs) {
+                    pending.wait();
+                }
+                pendingConfigs.clear();
+
+                return lastError;
+            }
 
             /**
              * @brief 
-             *      Slowest the wheel is allowed to move (when negative this
-             *      is max reverse speed); when set to zero, this is ignored
+             *      Returns the pointer to the MotorType class for specific use
+             *      cases
+             * @return 
+             *      Pointer to class MotorType
              */
-            units::meters_per_second_t lowerVelocitySoftLimit;
+            MotorType* GetMotorPointer() { return motor; }
 
             /**
              * @brief 
-             *      Fastest the wheel is allowed to move (must be greater than 
-             *      lowerVelocitySoftLimit); when set to zero, this is ignored
+             *      Sets the motor output percentage
+             * @param percent
+             *      A percentage from [-1, 1]; exceeding this interval may
+             *      cause undefined behavior
              */
-            units::meters_per_second_t upperVelocitySoftLimit;
+            void Set(double percent) {
+                motor->Set(percent);
+                commandedVoltage = std::clamp(percent, -1.0, 1.0) * frc::RobotController::GetBatteryVoltage();
+                MarkActive();
+            }
 
             /**
              * @brief 
-             *      Global integral zone of error in units per millisecond; 
-             *      units are not checked!
+             *      Returns the setpoint type currently in use; this is 
+             *      determined by previously called methods
+             * @return 
+             *      The setpoint type currently in use; see the SetpointType 
+             *      enum for what these types are
              */
-            double izone;
+            SetpointType GetSetpointType() { return published.Load().setpointType; }
 
             /**
              * @brief 
-             *      Gear ratio used to convert from m and m/s to encoder ticks
-             */
+             *      Returns the current position setpoint; use 
+             *      GetSetpointType() to check if this is the active setpoint
+             * @return 
+             *      The distance of the position setpoint in units::meter_t
+             */
+            units::meter_t GetPositionSetpoint() { return published.Load().positionSetpoint; }
+
+            /**
+             * @brief 
+             *      Returns th current linear velocity setpoint; use 
+             *      GetSetpointType() to check if this is the active setpoint
+             * @return 
+             *      The velocity of the linear velocity setpoint in 
+             *      units::meters_per_secont_t
+             */
+            units::meters_per_second_t GetVelocitySetpoint() { return published.Load().velocitySetpoint; }
+
+            /**
+             * @brief 
+             *      Returns the angular velocity setpoint; use 
+             *      GetSetpointType() to check if this is the active setpoint
+             * @return 
+             *      The angular velocity of the angular velocity setpoint in 
+             *      units::radians_per_second_t
+             */
+            units::radians_per_second_t GetAngularVelocitySetpoint() { return published.Load().angularVelocitySetpoint; }
+
+            /**
+             * @brief 
+             *      Returns the angular position setpoint as commanded, i.e. 
+             *      after continuous input wrapping; use GetSetpointType() to 
+             *      check if this is the active setpoint
+             * @return 
+             *      The angle of the angular position setpoint in 
+             *      units::radian_t
+             */
+            units::radian_t GetAngularPositionSetpoint() { return published.Load().angularPositionSetpoint; }
+
+            /**
+             * @brief 
+             *      Returns the angle of the output shaft, not wrapped
+             * @return 
+             *      units::radian_t representing the angle of the output shaft
+             */
+            units::radian_t GetActualAngularPosition() { return Snapshot().angularPosition; }
+
+            /**
+             * @brief 
+             *      Enables or disables continuous input for angular position 
+             *      setpoints, for mechanisms that can spin freely such as 
+             *      swerve steering; any angle is then reached through the 
+             *      shortest rotation, never more than half a turn
+             * @param isContinuous
+             *      When true, angular position setpoints wrap
+             */
+            void SetContinuousInput(bool isContinuous) { isContinuousInput = isContinuous; }
+
+            /**
+             * @brief 
+             *      Returns whether angular position setpoints wrap
+             * @return 
+             *      True if continuous input is enabled
+             */
+            bool IsContinuousInput() { return isContinuousInput; }
+
+            /**
+             * @brief 
+             *      Returns the cruise velocity of the motion profile used by 
+             *      profiled position setpoints
+             * @return 
+             *      The max profile velocity in units::meters_per_second_t
+             */
+            units::meters_per_second_t GetMaxProfileVelocity() { return maxProfileVelocity; }
+
+            /**
+             * @brief 
+             *      Returns the acceleration of the motion profile used by 
+             *      profiled position setpoints
+             * @return 
+             *      The max profile acceleration in 
+             *      units::meters_per_second_squared_t
+             */
+            units::meters_per_second_squared_t GetMaxProfileAcceleration() { return maxProfileAcceleration; }
+
+            /**
+             * @brief 
+             *      Returns the last recorded error, if any
+             * @return 
+             *      Type based on template of the class; the last error known 
+             *      to have occurred
+             */
+            ErrorEnum GetLastError() { return lastError; }
+
+            /**
+             * @brief 
+             *      Sets the gear ratio to be used for calculations between 
+             *      unit conversions of the wheel and actual motor rotation
+             * @param ratio
+             *      The desired gear ratio as a decimal value (output to input)
+             */
+            void SetGearing(double ratio) { gearing = ratio; UpdateConversionFactors(); }
+
+            /**
+             * @brief 
+             *      Returns the configured gear ratio as a decimal value
+             * @return 
+             *      The gear ratio currently being used to determine how motor 
+             *      rotation correlates to distance and velocity
+             */
+            double GetGearing() { return gearing; }
+
+            /**
+             * @brief 
+             *      Sets the desired wheel diameter, in meters, to be used for 
+             *      calculating distances and velocities
+             * @param diameter
+             *      Desired wheel diameter in units::meter_t
+             */
+            void SetWheelDiameter(units::meter_t diameter) { wheelDiameter = diameter; UpdateConversionFactors(); }
+
+            units::meter_t GetWheelDiameter() { return wheelDiameter; }
+
+            /**
+             * @brief 
+             *      Attaches an absolute sensor that seeds the integrated 
+             *      sensor with the true mechanism position, then seeds it 
+             *      right away through Reset()
+             * 
+             * From then on, Reset() seeds the integrated sensor from the 
+             * absolute sensor instead of zeroing it, so the mechanism is ready
+             * as soon as the robot boots, without homing. The reading is 
+             * wrapped into [-0.5, 0.5) turns after the offset is removed, so 
+             * the sensor must turn less than once over the mechanism's travel,
+             * and that travel may extend either side of zero. When the sensor
+             * has no valid reading, Reset() zeroes the integrated sensor 
+             * instead and IsAbsoluteSeedValid() returns false.
+             * @param sensor
+             *      Callable returning the absolute reading of the sensor, or 
+             *      std::nullopt when it has none, e.g. from 
+             *      sensors::FromCANCoder() or sensors::FromDutyCycle()
+             * @param ratio
+             *      Turns of the output shaft per turn of the sensor
+             * @param offset
+             *      Reading of the sensor when the mechanism is at zero
+             * @return 
+             *      True if the integrated sensor was seeded from the absolute
+             *      sensor, false if it was zeroed for lack of a valid reading
+             * @see AbsoluteSensor.h
+             */
+            bool SetAbsoluteSensor(std::function<std::optional<units::turn_t>()> sensor, double ratio = 1.0, units::turn_t offset = 0.0_tr) {
+                absoluteSensor = std::move(sensor);
+                absoluteSensorRatio = ratio;
+                absoluteSensorOffset = offset;
+                Reset();
+
+                return isAbsoluteSeedValid;
+            }
+
+            /**
+             * @brief 
+             *      Returns whether the last Reset() seeded the integrated 
+             *      sensor from the absolute sensor
+             * @return 
+             *      False when no absolute sensor is attached or it had no 
+             *      valid reading, and the integrated sensor was zeroed
+             */
+            bool IsAbsoluteSeedValid() { return isAbsoluteSeedValid; }
+
+            /**
+             * @brief 
+             *      Sends the output of a simple motor feedforward (static 
+             *      friction and velocity) as an arbitrary feedforward with 
+             *      every setpoint
+             * @param model
+             *      The feedforward, with velocities in m/s
+             */
+            void SetFeedforward(const frc::SimpleMotorFeedforward<units::meters>& model) {
+                feedforward = [model](units::meter_t, units::meters_per_second_t velocity) {
+                    return model.Calculate(velocity);
+                };
+            }
+
+            /**
+             * @brief 
+             *      Sends the output of an elevator feedforward (static 
+             *      friction, gravity and velocity) as an arbitrary 
+             *      feedforward with every setpoint
+             * @param model
+             *      The feedforward, with velocities in m/s
+             */
+            void SetFeedforward(const frc::ElevatorFeedforward& model) {
+                feedforward = [model](units::meter_t, units::meters_per_second_t velocity) {
+                    return model.Calculate(velocity);
+                };
+            }
+
+            /**
+             * @brief 
+             *      Sends the output of an arm feedforward (static friction, 
+             *      gravity and velocity) as an arbitrary feedforward with 
+             *      every setpoint
+             * 
+             * The angle of the arm is the position the feedforward is 
+             * evaluated at, converted to radians of the output shaft with the
+             * wheel diameter. Position and profiled setpoints evaluate gravity
+             * at their target, so the arm is held where it ends up; velocity 
+             * setpoints evaluate it at the measured position when they are 
+             * sent. The feedforward is only computed when a setpoint is sent,
+             * so it does not follow the arm through a profiled move.
+             * @param model
+             *      The feedforward
+             * @param angleOffset
+             *      Angle of the arm from horizontal when the position is zero
+             *      in units::radian_t (default 0, horizontal)
+             */
+            void SetFeedforward(const frc::ArmFeedforward& model, units::radian_t angleOffset = 0.0_rad) {
+                feedforward = [this, model, angleOffset](units::meter_t position, units::meters_per_second_t velocity) {
+                    // meters at the wheel -> radians of the output shaft
+                    double radiansPerMeter = 2.0 / (double)wheelDiameter;
+                    return model.Calculate(
+                        units::radian_t((double)position * radiansPerMeter) + angleOffset,
+                        units::radians_per_second_t((double)velocity * radiansPerMeter)
+                    );
+                };
+            }
+
+            /**
+             * @brief 
+             *      Stops sending an arbitrary feedforward with setpoints
+             */
+            void ClearFeedforward() { feedforward = nullptr; }
+
+            /**
+             * @brief 
+             *      Sets the velocity soft limits in m/s; velocity setpoints 
+             *      outside of [minvel, maxvel] are clamped to the interval, and
+             *      angular velocity setpoints are clamped to the equivalent 
+             *      speed at the wheel. Passing equal values disables them, 
+             *      and limits given in the wrong order are swapped
+             * @param minvel
+             *      Minimum velocity in units::meters_per_second_t (negative 
+             *      for the fastest reverse speed)
+             * @param maxvel
+             *      Maximum velocity in units::meters_per_second_t
+             */
+            void SetVelocitySoftLimits(units::meters_per_second_t minvel, units::meters_per_second_t maxvel) {
+                // std::clamp() is undefined for an empty interval
+                lowerVelocitySoftLimit = std::min(minvel, maxvel);
+                upperVelocitySoftLimit = std::max(minvel, maxvel);
+            }
+
+        protected:
+            /**
+             * @brief 
+             *      Returns the angle to command for an angular position 
+             *      setpoint; with continuous input, this is the angle 
+             *      equivalent to the requested one that is closest to the 
+             *      measured angle
+             * @param angle
+             *      The requested angle of the output shaft
+             * @return 
+             *      The angle to send to the motor controller
+             */
+            units::radian_t GetNearestAngle(units::radian_t angle) {
+                if (!isContinuousInput) {
+                    return angle;
+                }
+
+                units::radian_t current = Snapshot().angularPosition;
+                return current + frc::AngleModulus(angle - current);
+            }
+
+            /**
+             * @brief 
+             *      Computes the arbitrary feedforward sent with a velocity 
+             *      setpoint, using the latest measured position
+             * @param velocity
+             *      The velocity the setpoint asks for
+             * @return 
+             *      The feedforward voltage, or zero when no model is set
+             */
+            units::volt_t CalculateFeedforward(units::meters_per_second_t velocity) {
+                return CalculateFeedforward(published.Load().position, velocity);
+            }
+
+            /**
+             * @brief 
+             *      Computes the arbitrary feedforward sent with a setpoint at a
+             *      given position, e.g. the target of a position setpoint
+             * @param position
+             *      The position the feedforward is evaluated at
+             * @param velocity
+             *      The velocity the setpoint asks for (zero for positions)
+             * @return 
+             *      The feedforward voltage, or zero when no model is set
+             */
+            units::volt_t CalculateFeedforward(units::meter_t position, units::meters_per_second_t velocity) {
+                if (!feedforward) {
+                    return 0.0_V;
+                }
+
+                return feedforward(position, velocity);
+            }
+
+            /**
+             * @brief 
+             *      Returns the position the integrated sensor is set to by 
+             *      Reset()
+             * @return 
+             *      The mechanism position measured by the absolute sensor, or
+             *      zero when there is none or it has no valid reading
+             */
+            units::meter_t GetSeedPosition() {
+                std::optional<units::turn_t> reading = absoluteSensor ? absoluteSensor() : std::nullopt;
+                isAbsoluteSeedValid = reading.has_value();
+                if (!isAbsoluteSeedValid) {
+                    return 0.0_m;
+                }
+
+                // Centered on zero, so travel on either side of it is kept
+                double turns = std::fmod((double)(*reading - absoluteSensorOffset), 1.0);
+                if (turns < -0.5) {
+                    turns += 1.0;
+                } else if (turns >= 0.5) {
+                    turns -= 1.0;
+                }
+
+                // sensor turns -> output shaft turns -> meters
+                return units::meter_t(turns * absoluteSensorRatio * (double)wheelDiameter * M_PI);
+            }
+
+            /**
+             * @brief 
+             *      Clamps a linear velocity setpoint to the velocity soft 
+             *      limits, if they are enabled
+             * @param lvelocity
+             *      The requested linear velocity
+             * @return 
+             *      The linear velocity to send to the motor controller
+             */
+            units::meters_per_second_t ClampVelocity(units::meters_per_second_t lvelocity) {
+                if (lowerVelocitySoftLimit == upperVelocitySoftLimit) {
+                    return lvelocity;
+                }
+
+                return std::clamp(lvelocity, lowerVelocitySoftLimit, upperVelocitySoftLimit);
+            }
+
+            /**
+             * @brief 
+             *      Clamps an angular velocity setpoint of the output shaft to 
+             *      the velocity soft limits at the wheel, if they are enabled
+             * @param avelocity
+             *      The requested angular velocity
+             * @return 
+             *      The angular velocity to send to the motor controller
+             */
+            units::radians_per_second_t ClampVelocity(units::radians_per_second_t avelocity) {
+                if (lowerVelocitySoftLimit == upperVelocitySoftLimit) {
+                    return avelocity;
+                }
+
+                // m/s at the wheel -> rad/s of the output shaft
+                double radiansPerMeter = 2.0 / (double)wheelDiameter;
+                return std::clamp(
+                    avelocity,
+                    units::radians_per_second_t((double)lowerVelocitySoftLimit * radiansPerMeter),
+                    units::radians_per_second_t((double)upperVelocitySoftLimit * radiansPerMeter)
+                );
+            }
+
+            /**
+             * @brief 
+             *      Returns the published MotorState, calling Refresh() first 
+             *      if it is older than the max state age; this is called by 
+             *      every getter
+             * 
+             * Refresh() serializes itself on the refresh mutex, so a reader 
+             * that finds the state stale never runs it alongside the 
+             * scheduler or another reader; set the max state age to zero to 
+             * keep readers from refreshing at all.
+             * @return 
+             *      A consistent copy of the published MotorState
+             */
+            MotorState Snapshot() {
+                MotorState snapshot = published.Load();
+                if (stateMaxAge > 0.0_s && frc::Timer::GetFPGATimestamp() - snapshot.timestamp > stateMaxAge) {
+                    Refresh();
+                    snapshot = published.Load();
+                }
+                return snapshot;
+            }
+
+            /**
+             * @brief 
+             *      Publishes the signals read by Refresh(), keeping the 
+             *      published setpoint
+             * @param sample
+             *      The signals read from the motor controller; its setpoint 
+             *      fields are ignored
+             */
+            void PublishMeasurement(const MotorState& sample) {
+                std::lock_guard<std::mutex> lock(publishMutex);
+
+                MotorState next = sample;
+                next.setpointType = state.setpointType;
+                next.positionSetpoint = state.positionSetpoint;
+                next.velocitySetpoint = state.velocitySetpoint;
+                next.angularVelocitySetpoint = state.angularVelocitySetpoint;
+                next.angularPositionSetpoint = state.angularPositionSetpoint;
+                state = next;
+                published.Store(state);
+            }
+
+            /**
+             * @brief 
+             *      Reads the state of a plant driven mechanism the way 
+             *      Refresh() would read the motor controller; called by 
+             *      Refresh() while holding the refresh mutex
+             * @param countsPerRev
+             *      Encoder counts per motor revolution of the motor controller
+             * @return 
+             *      The measured state, without setpoints
+             * @see SetPlantDriven()
+             */
+            MotorState ReadPlant(double countsPerRev) {
+                MotorState sample;
+                sample.angularPosition = mechanism->GetAngle() - plantZero;
+                sample.angularVelocity = mechanism->GetAngularVelocity();
+
+                // output shaft -> wheel; output shaft -> motor revolutions
+                sample.position = units::meter_t((double)sample.angularPosition * (double)wheelDiameter / 2.0);
+                sample.velocity = units::meters_per_second_t((double)sample.angularVelocity * (double)wheelDiameter / 2.0);
+                sample.rawEncoderCounts = (int)((double)sample.angularPosition / (2.0 * M_PI) * gearing * countsPerRev);
+
+                sample.current = units::math::abs(mechanism->GetCurrentDraw());
+                units::volt_t battery = frc::RobotController::GetBatteryVoltage();
+                sample.voltage = std::clamp(commandedVoltage.load(), -battery, battery);
+                sample.isFwdLimitSwitchPressed = mechanism->IsAtUpperLimit();
+                sample.isRevLimitSwitchPressed = mechanism->IsAtLowerLimit();
+
+                sample.timestamp = frc::Timer::GetFPGATimestamp();
+                return sample;
+            }
+
+            /**
+             * @brief 
+             *      Advances a plant driven mechanism by one time step using 
+             *      the commanded voltage, limited to the battery voltage
+             * @param dt
+             *      The length of the time step in units::second_t
+             */
+            void StepPlant(units::second_t dt) {
+                std::lock_guard<std::mutex> lock(refreshMutex);
+
+                units::volt_t battery = frc::RobotController::GetBatteryVoltage();
+                mechanism->SetInputVoltage(std::clamp(commandedVoltage.load(), -battery, battery));
+                mechanism->Update(dt);
+            }
+
+            /**
+             * @brief 
+             *      Moves the zero of a plant driven mechanism so it reads the
+             *      given position, the way Reset() sets the encoder; does 
+             *      nothing without an attached mechanism
+             * @param position
+             *      The position the mechanism reads from now on
+             */
+            void SeedPlant(units::meter_t position) {
+                std::lock_guard<std::mutex> lock(refreshMutex);
+
+                if (mechanism) {
+                    // wheel -> output shaft
+                    plantZero = mechanism->GetAngle() - units::radian_t((double)position * 2.0 / (double)wheelDiameter);
+                }
+            }
+
+            /**
+             * @brief 
+             *      Publishes the current setpoint type and setpoints, keeping
+             *      the published signals; called at the end of every setter
+             *      that changes them
+             * 
+             * The motor is only marked as active when it was stopped, when the
+             * setpoint type or value changed, or when the last measured state
+             * is outside the tolerance of the setpoint, so resending the same
+             * setpoint every loop lets the frames slow down once it is reached.
+             */
+            void PublishSetpoint() {
+                bool isActive = isStopped;
+                {
+                    std::lock_guard<std::mutex> lock(publishMutex);
+
+                    isActive = isActive
+                        || state.setpointType != setpointType
+                        || state.positionSetpoint != positionSetpoint
+                        || state.velocitySetpoint != velocitySetpoint
+                        || state.angularVelocitySetpoint != avelSetpoint
+                        || state.angularPositionSetpoint != apositionSetpoint;
+
+                    state.setpointType = setpointType;
+                    state.positionSetpoint = positionSetpoint;
+                    state.velocitySetpoint = velocitySetpoint;
+                    state.angularVelocitySetpoint = avelSetpoint;
+                    state.angularPositionSetpoint = apositionSetpoint;
+                    published.Store(state);
+
+                    isActive = isActive || !IsAtSetpoint(state);
+                }
+
+                // Closed loop setpoints run on the motor controller, which a 
+                // plant driven mechanism doesn't see
+                commandedVoltage = 0.0_V;
+
+                if (isActive) {
+                    MarkActive();
+                }
+            }
+
+            /**
+             * @brief 
+             *      Sets the status frame periods for a set of consumed 
+             *      signals; the frames carrying them run at their default 
+             *      rates and every other frame is slowed down
+             * @param signals
+             *      A bitmask of Signal values
+             * @return 
+             *      The first error reported while setting the frame periods
+             */
+            virtual ErrorEnum ApplySignalFrames(int /* signals */) = 0;
+
+            /**
+             * @brief 
+             *      Returns the signals whose frames should run at their 
+             *      default rates right now: the consumed signals, without the
+             *      feedback signals while idle, and the pinned signals; 
+             *      called while holding the adaptive mutex
+             * @return 
+             *      A bitmask of Signal values
+             */
+            int GetActiveSignals() {
+                int signals = isFrameRateIdle ? (consumedSignals & ~feedbackSignals) : consumedSignals;
+                return signals | pinnedSignals;
+            }
+
+            /**
+             * @brief 
+             *      Returns whether a state is within the tolerance of its 
+             *      setpoint
+             * @param snapshot
+             *      The state to check
+             * @return 
+             *      True if the setpoint is a position or velocity and the 
+             *      error is within its tolerance
+             */
+            bool IsAtSetpoint(const MotorState& snapshot) {
+                switch (snapshot.setpointType) {
+                    case ePosition:
+                    case eProfiledPosition:
+                        return units::math::abs(snapshot.position - snapshot.positionSetpoint) <= positionTolerance;
+
+                    case eLinearVelocity:
+                        return units::math::abs(snapshot.velocity - snapshot.velocitySetpoint) <= velocityTolerance;
+
+                    case eAngularVelocity:
+                        return units::math::abs(snapshot.angularVelocity - snapshot.angularVelocitySetpoint) <= avelTolerance;
+
+                    case eAngularPosition:
+                        return units::math::abs(snapshot.angularPosition - snapshot.angularPositionSetpoint) <= apositionTolerance;
+
+                    default:
+                        return false;
+                }
+            }
+
+            /**
+             * @brief 
+             *      Records that the motor was given a setpoint or output; 
+             *      clears the stopped flag and brings slowed down feedback 
+             *      frames back to their full rate
+             */
+            void MarkActive() {
+                isStopped = false;
+
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                idleSince = -1.0_s;
+                if (isFrameRateIdle) {
+                    isFrameRateIdle = false;
+                    ApplySignalFrames(GetActiveSignals());
+                }
+            }
+
+            /**
+             * @brief 
+             *      Slows the feedback frames down once the latest state has 
+             *      been idle for the idle delay, or restores them as soon as 
+             *      it isn't; called by Refresh() after publishing
+             */
+            void UpdateFrameRates() {
+                MotorState snapshot = published.Load();
+
+                std::lock_guard<std::mutex> lock(adaptiveMutex);
+                if (!isAdaptiveFrameRate) {
+                    return;
+                }
+
+                bool isIdle = (isStopped || snapshot.setpointType == eNone || IsAtSetpoint(snapshot)) 
+                    && units::math::abs(snapshot.velocity) <= adaptiveIdleVelocity;
+
+                if (!isIdle) {
+                    idleSince = -1.0_s;
+                    if (isFrameRateIdle) {
+                        isFrameRateIdle = false;
+                        ApplySignalFrames(GetActiveSignals());
+                    }
+                    return;
+                }
+
+                if (idleSince < 0.0_s) {
+                    idleSince = snapshot.timestamp;
+                }
+                if (!isFrameRateIdle && snapshot.timestamp - idleSince >= adaptiveIdleDelay) {
+                    isFrameRateIdle = true;
+                    ApplySignalFrames(GetActiveSignals());
+                }
+            }
+
+            /**
+             * @brief 
+             *      A registered event callback
+             */
+            struct EventListener {
+                /** @brief Id returned to the caller that added the listener */
+                int id;
+                /** @brief The event the listener waits for */
+                MotionEvent event;
+                /** @brief The threshold of a crossing event, in meters or m/s */
+                double threshold;
+                /** @brief Callable invoked when the event fires */
+                std::function<void()> callback;
+            };
+
+            /**
+             * @brief 
+             *      Registers a listener with a raw threshold
+             * @param event
+             *      The event to wait for
+             * @param threshold
+             *      The threshold of a crossing event, in meters or m/s
+             * @param callback
+             *      Callable invoked when the event fires
+             * @return 
+             *      The id of the listener
+             */
+            int AddEventListener(MotionEvent event, double threshold, std::function<void()> callback) {
+                std::lock_guard<std::mutex> lock(eventMutex);
+                listeners.push_back({ nextListenerId, event, threshold, std::move(callback) });
+                return nextListenerId++;
+            }
+
+            /**
+             * @brief 
+             *      Returns whether an event fired between two states
+             * @param listener
+             *      The listener to check
+             * @param previous
+             *      The state seen by the previous refresh
+             * @param current
+             *      The state seen by this refresh
+             * @return 
+             *      True if the transition of the listener's event happened
+             */
+            bool IsEventFired(const EventListener& listener, const MotorState& previous, const MotorState& current) {
+                switch (listener.event) {
+                    case eFwdLimitSwitchPressed:
+                        return !previous.isFwdLimitSwitchPressed && current.isFwdLimitSwitchPressed;
+                    case eFwdLimitSwitchReleased:
+                        return previous.isFwdLimitSwitchPressed && !current.isFwdLimitSwitchPressed;
+                    case eRevLimitSwitchPressed:
+                        return !previous.isRevLimitSwitchPressed && current.isRevLimitSwitchPressed;
+                    case eRevLimitSwitchReleased:
+                        return previous.isRevLimitSwitchPressed && !current.isRevLimitSwitchPressed;
+                    case eSetpointReached:
+                        return !IsAtSetpoint(previous) && IsAtSetpoint(current);
+                    case eSetpointLeft:
+                        return IsAtSetpoint(previous) && !IsAtSetpoint(current);
+                    case ePositionRoseAbove:
+                        return (double)previous.position < listener.threshold && (double)current.position >= listener.threshold;
+                    case ePositionFellBelow:
+                        return (double)previous.position >= listener.threshold && (double)current.position < listener.threshold;
+                    case eVelocityRoseAbove:
+                        return (double)previous.velocity < listener.threshold && (double)current.velocity >= listener.threshold;
+                    case eVelocityFellBelow:
+                        return (double)previous.velocity >= listener.threshold && (double)current.velocity < listener.threshold;
+                    default:
+                        return false;
+                }
+            }
+
+            /**
+             * @brief 
+             *      Compares the freshly published state to the one seen by the
+             *      previous refresh and collects the callbacks of every event 
+             *      that fired; called by Refresh() after publishing, which 
+             *      runs them once the refresh mutex is released
+             * 
+             * A state that is no newer than the previous one is ignored. The 
+             * previous measurement is compared against the current setpoint,
+             * so commanding a new setpoint doesn't count as leaving the old 
+             * one.
+             * @return 
+             *      The callbacks to run, in the order they were added
+             */
+            std::vector<std::function<void()>> CollectEvents() {
+                MotorState current = published.Load();
+                std::vector<std::function<void()>> fired;
+
+                {
+                    std::lock_guard<std::mutex> lock(eventMutex);
+
+                    if (hasEventState && current.timestamp <= eventState.timestamp) {
+                        return fired;
+                    }
+
+                    // The first refresh only establishes the baseline
+                    if (hasEventState) {
+                        MotorState previous = eventState;
+                        previous.setpointType = current.setpointType;
+                        previous.positionSetpoint = current.positionSetpoint;
+                        previous.velocitySetpoint = current.velocitySetpoint;
+                        previous.angularVelocitySetpoint = current.angularVelocitySetpoint;
+                        previous.angularPositionSetpoint = current.angularPositionSetpoint;
+
+                        for (const EventListener& listener : listeners) {
+                            if (IsEventFired(listener, previous, current)) {
+                                fired.push_back(listener.callback);
+                            }
+                        }
+                    }
+
+                    eventState = current;
+                    hasEventState = true;
+                }
+
+                return fired;
+            }
+
+            /**
+             * @brief 
+             *      Sends a configuration write to the motor controller only if
+             *      the value differs from the last one written for the same 
+             *      parameter and slot
+             * 
+             * In async configuration mode, the write is queued on the 
+             * ConfigQueue and this returns immediately.
+             * @param param
+             *      The configuration parameter being written
+             * @param slot
+             *      The slot (or other index) of the parameter; 0 for 
+             *      parameters without one
+             * @param value
+             *      The value being written, in the motor controller's units
+             * @param write
+             *      Copyable callable performing the actual vendor call; it is
+             *      passed the timeout in milliseconds to wait for an 
+             *      acknowledgement and returns the vendor's ErrorEnum
+             * @return 
+             *      The error reported by the write, or the default ErrorEnum 
+             *      (no error) when the write was skipped or queued
+             */
+            template <typename WriteFunc>
+            ErrorEnum IssueConfig(ConfigParam param, int slot, double value, WriteFunc write) {
+                auto key = std::make_pair(param, slot);
+
+                {
+                    std::lock_guard<std::mutex> lock(configMutex);
+                    auto shadow = configShadow.find(key);
+
+                    if (shadow != configShadow.end() && shadow->second == value) {
+                        configStats.suppressed++;
+                        return ErrorEnum{};
+                    }
+
+                    // Recorded up front so the same value isn't queued twice; 
+                    // a failed write removes it again
+                    configShadow[key] = value;
+                    configStats.issued++;
+                }
+
+                if (!isAsyncConfig) {
+                    // Synchronous writes keep the vendor's non-waiting default
+                    return FinishConfig(key, value, write(0));
+                }
+
+                int timeoutMs = (int)units::millisecond_t(asyncConfigTimeout).value();
+
+                PrunePendingConfigs();
+                pendingConfigs.push_back(ConfigQueue<ErrorEnum>::GetInstance().Enqueue(
+                    [this, key, value, write, timeoutMs] {
+                        return FinishConfig(key, value, write(timeoutMs));
+                    }
+                ));
+
+                return ErrorEnum{};
+            }
+
+            /**
+             * @brief 
+             *      Records the result of a configuration write; on error, the
+             *      shadow value is forgotten so the write is retried, and the
+             *      error is stored as the last error
+             * @param key
+             *      The parameter and slot that were written
+             * @param value
+             *      The value that was written
+             * @param error
+             *      The error reported by the write
+             * @return 
+             *      The error that was passed in
+             */
+            ErrorEnum FinishConfig(std::pair<ConfigParam, int> key, double value, ErrorEnum error) {
+                if (error != ErrorEnum{}) {
+                    std::lock_guard<std::mutex> lock(configMutex);
+                    configStats.failed++;
+
+                    // Leave a newer value alone if one was written since
+                    auto shadow = configShadow.find(key);
+                    if (shadow != configShadow.end() && shadow->second == value) {
+                        configShadow.erase(shadow);
+                    }
+
+                    lastError = error;
+                }
+
+                return error;
+            }
+
+            /**
+             * @brief 
+             *      Drops every finished write from the front of the pending 
+             *      configuration list
+             */
+            void PrunePendingConfigs() {
+                while (
+                    !pendingConfigs.empty() && 
+                    pendingConfigs.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready
+                ) {
+                    pendingConfigs.pop_front();
+                }
+            }
+
+            /**
+             * @brief 
+             *      Pointer to class MotorType, based on template of the class
+             */
+            MotorType* motor;
+
+            /**
+             * @brief 
+             *      Shadow copy of every configuration value written to the 
+             *      motor controller, keyed by parameter and slot
+             */
+            std::map<std::pair<ConfigParam, int>, double> configShadow;
+
+            /**
+             * @brief 
+             *      Counters of issued, suppressed and failed configuration 
+             *      writes
+             */
+            ConfigStats configStats;
+
+            /**
+             * @brief 
+             *      Bitmask of the Signal values this mechanism reads
+             */
+            int consumedSignals = eSignalAll;
+
+            /**
+             * @brief 
+             *      Bitmask of the Signal values kept at their default rates 
+             *      through PinSignals()
+             */
+            int pinnedSignals = eSignalNone;
+
+            /**
+             * @brief 
+             *      The signals whose frames adaptive frame rates slow down 
+             *      while the mechanism is idle
+             */
+            static constexpr int feedbackSignals = eSignalPosition | eSignalVelocity | eSignalCurrent;
+
+            /**
+             * @brief 
+             *      Guards the adaptive frame rate state, which is updated by 
+             *      both Refresh() and the setpoint setters
+             */
+            std::mutex adaptiveMutex;
+
+            /**
+             * @brief 
+             *      Whether feedback frames follow the motion state
+             */
+            bool isAdaptiveFrameRate = false;
+
+            /**
+             * @brief 
+             *      Whether the feedback frames are currently slowed down
+             */
+            bool isFrameRateIdle = false;
+
+            /**
+             * @brief 
+             *      The fastest the mechanism can move while idle
+             */
+            units::meters_per_second_t adaptiveIdleVelocity = 0.01_mps;
+
+            /**
+             * @brief 
+             *      How long the mechanism must stay idle before its feedback 
+             *      frames are slowed down
+             */
+            units::second_t adaptiveIdleDelay = 0.25_s;
+
+            /**
+             * @brief 
+             *      Timestamp of the first idle state in the current idle 
+             *      stretch; negative while the mechanism isn't idle
+             */
+            units::second_t idleSince = -1.0_s;
+
+            /**
+             * @brief 
+             *      Set by Stop() and cleared by any new setpoint or output
+             */
+            std::atomic<bool> isStopped{false};
+
+            /**
+             * @brief 
+             *      Guards the listeners and the state they are compared to
+             */
+            std::mutex eventMutex;
+
+            /**
+             * @brief 
+             *      Registered event listeners, in the order they were added
+             */
+            std::vector<EventListener> listeners;
+
+            /**
+             * @brief 
+             *      Id given to the next listener added
+             */
+            int nextListenerId = 0;
+
+            /**
+             * @brief 
+             *      The state seen by the previous CollectEvents() call
+             */
+            MotorState eventState;
+
+            /**
+             * @brief 
+             *      Whether eventState holds a refreshed state yet
+             */
+            bool hasEventState = false;
+
+            /**
+             * @brief 
+             *      Current period of every status frame the motor controller 
+             *      sends, keyed by the vendor's frame ID; filled in with the 
+             *      factory defaults by the derived class
+             */
+            std::map<int, units::millisecond_t> statusFramePeriods;
+
+            /**
+             * @brief 
+             *      Guards the shadow configuration cache and its counters, 
+             *      which the ConfigQueue worker thread updates as well
+             */
+            std::mutex configMutex;
+
+            /**
+             * @brief 
+             *      When true, configuration writes are queued on the 
+             *      ConfigQueue rather than run on the calling thread
+             */
+            bool isAsyncConfig = false;
+
+            /**
+             * @brief 
+             *      How long the worker thread waits for each async 
+             *      configuration write to be acknowledged
+             */
+            units::second_t asyncConfigTimeout = 0.1_s;
+
+            /**
+             * @brief 
+             *      Futures of this motor's queued configuration writes, oldest
+             *      first
+             */
+            std::deque<std::shared_future<ErrorEnum>> pendingConfigs;
+
+            /**
+             * @brief 
+             *      Writer-side copy of the last published MotorState; only 
+             *      touched while holding the publish mutex
+             */
+            MotorState state;
+
+            /**
+             * @brief 
+             *      Serializes the writers of the published state, e.g. a 
+             *      control thread calling Refresh() while the robot loop sets
+             *      a setpoint; readers never take this
+             */
+            std::mutex publishMutex;
+
+            /**
+             * @brief 
+             *      The MotorState as seen by readers on any thread
+             */
+            SeqLock<MotorState> published;
+
+            /**
+             * @brief 
+             *      Serializes Refresh(); released before the event callbacks
+             *      run
+             */
+            std::mutex refreshMutex;
+
+            /**
+             * @brief 
+             *      Max age of the cached state before a getter refreshes it; 
+             *      this is short enough that each robot loop reads the motor
+             *      once, no matter how many times it is read
+             */
+            units::second_t stateMaxAge = 0.005_s;
+
+            /**
+             * @brief 
+             *      Last error to have known to occurred; this is atomic since
+             *      async configuration writes report errors from the 
+             *      ConfigQueue worker thread
+             */
+            std::atomic<ErrorEnum> lastError{ErrorEnum{}};
+
+            /**
+             * @brief 
+             *      Physics model of the driven mechanism, used in simulation
+             */
+            std::unique_ptr<simulation::MechanismSim> mechanism;
+
+            /**
+             * @brief 
+             *      Whether the attached mechanism is driven from the roboRIO 
+             *      rather than the simulated motor controller
+             */
+            std::atomic<bool> isPlantDriven{false};
+
+            /**
+             * @brief 
+             *      Open loop voltage last commanded through Set(), 
+             *      SetMotorVoltage() or Stop(); zero under a closed loop 
+             *      setpoint. This is what a plant driven mechanism is driven
+             *      with.
+             */
+            std::atomic<units::volt_t> commandedVoltage{0.0_V};
+
+            /**
+             * @brief 
+             *      Output shaft angle of the plant driven mechanism that reads
+             *      as zero; moved by Reset()
+             */
+            units::radian_t plantZero = 0.0_rad;
+
+            /**
+             * @brief 
+             *      Whether the motor is inverted; simulation uses this to map
+             *      the motor's direction onto the mechanism's
+             */
+            bool isInverted = false;
+
+            /**
+             * @brief 
+             *      SetpointType enum type recording the currently in-use 
+             *      setpoint
+             */
+            SetpointType setpointType;
+
+            /* Primitive member types */
+
+            /**
+             * @brief 
+             *      Is forward limit switch Normally Open?
+             */
+            bool isFwdLimitSwitchNO;
+
+            /**
+             * @brief 
+             *      Is reverse limit switch Normally Open?
+             */
+            bool isRevLimitSwitchNO;
+
+            /**
+             * @brief 
+             *      Current position setpoint in units::meter_t; this describes
+             *      how far the wheel should travel compared to its position 
+             *      when first initializing
+             */
+            units::meter_t positionSetpoint;
+
+            /**
+             * @brief 
+             *      Current linear velocity setpoint in 
+             *      units::meters_per_second_t; this describes how fast the 
+             *      wheel should move
+             */
+            units::meters_per_second_t velocitySetpoint;
+
+            /**
+             * @brief 
+             *      Current angular velocity setpoint in 
+             *      units::radians_per_second_t; this describes how fast the 
+             *      output shaft should spin (2pi rad/s = 1/60 rpm)
+             */
+            units::radians_per_second_t avelSetpoint;
+
+            /**
+             * @brief 
+             *      Current angular position setpoint in units::radian_t, as 
+             *      commanded after continuous input wrapping
+             */
+            units::radian_t apositionSetpoint = 0.0_rad;
+
+            /**
+             * @brief 
+             *      Whether angular position setpoints take the shortest 
+             *      rotation to an equivalent angle
+             */
+            bool isContinuousInput = false;
+
+            /**
+             * @brief 
+             *      Proportional gain for the closed feedback controller for 
+             *      position
+             */
+            double positionProportional;
+
+            /**
+             * @brief 
+             *      Integral gain for the closed feedback controller for
+             *      position
+             */
+            double positionIntegral;
+            
+            /**
+             * @brief 
+             *      Derivative gain for the closed feedback controller for 
+             *      position
+             */
+            double positionDerivative;
+
+            /**
+             * @brief 
+             *      Feed forward gain for the closed feedback controller for 
+             *      position
+             */
+            double positionFeedForward;
+
+            /**
+             * @brief 
+             *      Maximum allowed error of the setpoint; this should be as 
+             *      small as your PID values are accurate
+             */
+            units::meter_t positionTolerance;
+
+            /**
+             * @brief 
+             *      Proportional gain for the closed feedback controller for 
+             *      linear velocity
+             */
+            double velocityProportional;
+
+            /**
+             * @brief 
+             *      Integral gain for the closed feedback controller for 
+             *      linear velocity
+             */
+            double velocityIntegral;
+
+            /**
+             * @brief 
+             *      Derivative gain for the closed feedback controller for 
+             *      linear velocity
+             */
+            double velocityDerivative;
+
+            /**
+             * @brief 
+             *      Feed forward gain for the closed feedback controller for 
+             *      linear velocity
+             */
+            double velocityFeedForward;
+
+            /**
+             * @brief 
+             *      Maximum allowed error of the setpoint; this should be as 
+             *      small as your PID values are accurate
+             */
+            units::meters_per_second_t velocityTolerance;
+
+            /**
+             * @brief 
+             *      Proportional gain of the closed feedback controller for 
+             *      angular velocity
+             */
+            double avelProportional;
+
+            /**
+             * @brief 
+             *      Integral gain for the closed feedback controller for 
+             *      angular velocity
+             */
+            double avelIntegral;
+
+            /**
+             * @brief 
+             *      Derivative gain for the closed feedback controller for 
+             *      angular velocity
+             */
+            double avelDerivative;
+
+            /**
+             * @brief 
+             *      Feed forward gain for the closed feedback controller for 
+             *      angular velocity
+             */
+            double avelFeedForward;
+
+            /**
+             * @brief 
+             *      Maximum allowed error of the setpoint; this should be as 
+             *      small as your PID values are accurate
+             */
+            units::radians_per_second_t avelTolerance;
+
+            /**
+             * @brief 
+             *      Maximum allowed error of the angular position setpoint
+             */
+            units::radian_t apositionTolerance = 0.0_rad;
+
+            /**
+             * @brief 
+             *      Proportional gain for the closed feedback controller for 
+             *      profiled position
+             */
+            double profiledProportional;
+
+            /**
+             * @brief 
+             *      Integral gain for the closed feedback controller for 
+             *      profiled position
+             */
+            double profiledIntegral;
+
+            /**
+             * @brief 
+             *      Derivative gain for the closed feedback controller for 
+             *      profiled position
+             */
+            double profiledDerivative;
+
+            /**
+             * @brief 
+             *      Feed forward gain for the closed feedback controller for 
+             *      profiled position
+             */
+            double profiledFeedForward;
+
+            /**
+             * @brief 
+             *      Cruise velocity of the on-controller motion profile; when 
+             *      set to zero, no constraints have been configured
+             */
+            units::meters_per_second_t maxProfileVelocity;
+
+            /**
+             * @brief 
+             *      Acceleration of the on-controller motion profile
+             */
+            units::meters_per_second_squared_t maxProfileAcceleration;
+
+            /**
+             * @brief 
+             *      S-curve strength of the on-controller motion profile, from 
+             *      0 to 8
+             */
+            int profileSCurveStrength;
+
+            /**
+             * @brief 
+             *      Farthest back the motor is allowed to travel; when equal 
+             *      to upperPositionSoftLimit, the position soft limits are 
+             *      disabled
+             */
+            units::meter_t lowerPositionSoftLimit = 0.0_m;
+
+            /**
+             * @brief 
+             *      Farthest forward the motor is allowed to travel; when equal 
+             *      to lowerPositionSoftLimit, the position soft limits are 
+             *      disabled
+             */
+            units::meter_t upperPositionSoftLimit = 0.0_m;
+
+            /**
+             * @brief 
+             *      Slowest the wheel is allowed to move (when negative this
+             *      is max reverse speed); when equal to upperVelocitySoftLimit,
+             *      the velocity soft limits are disabled
+             */
+            units::meters_per_second_t lowerVelocitySoftLimit = 0.0_mps;
+
+            /**
+             * @brief 
+             *      Fastest the wheel is allowed to move (must be greater than 
+             *      lowerVelocitySoftLimit); when equal to 
+             *      lowerVelocitySoftLimit, the velocity soft limits are 
+             *      disabled
+             */
+            units::meters_per_second_t upperVelocitySoftLimit = 0.0_mps;
+
+            /**
+             * @brief 
+             *      Absolute sensor seeding the integrated sensor on Reset(); 
+             *      empty when there is none
+             */
+            std::function<std::optional<units::turn_t>()> absoluteSensor;
+
+            /**
+             * @brief 
+             *      Whether the last Reset() seeded the integrated sensor from
+             *      a valid absolute reading
+             */
+            std::atomic<bool> isAbsoluteSeedValid{false};
+
+            /**
+             * @brief 
+             *      Turns of the output shaft per turn of the absolute sensor
+             */
+            double absoluteSensorRatio = 1.0;
+
+            /**
+             * @brief 
+             *      Reading of the absolute sensor when the mechanism is at zero
+             */
+            units::turn_t absoluteSensorOffset = 0.0_tr;
+
+            /**
+             * @brief 
+             *      Feedforward model sent with every setpoint, taking the 
+             *      target or measured position and the velocity setpoint; 
+             *      empty when there is none
+             */
+            std::function<units::volt_t(units::meter_t, units::meters_per_second_t)> feedforward;
+
+            /**
+             * @brief 
+             *      Global integral zone of error in units per millisecond; 
+             *      units are not checked!
+             */
+            double izone;
+
+            /**
+             * @brief 
+             *      Gear ratio used to convert from m and m/s to encoder ticks
+             */
             double gearing;
 
             /**
@@ -666,6 +2590,64 @@ namespace laser {
              */
             units::meter_t wheelDiameter;
 
+            /* Unit conversion factors - updated through UpdateConversionFactors() */
+
+            /**
+             * @brief 
+             *      Motor controller position units per meter traveled by the 
+             *      wheel
+             */
+            double nativePerMeter = 1.0;
+
+            /**
+             * @brief 
+             *      Meters traveled by the wheel per motor controller position
+             *      unit; the inverse of nativePerMeter
+             */
+            double metersPerNative = 1.0;
+
+            /**
+             * @brief 
+             *      Motor controller velocity units per meter per second of 
+             *      wheel speed
+             */
+            double nativePerMps = 1.0;
+
+            /**
+             * @brief 
+             *      Meters per second of wheel speed per motor controller 
+             *      velocity unit; the inverse of nativePerMps
+             */
+            double mpsPerNative = 1.0;
+
+            /**
+             * @brief 
+             *      Motor controller velocity units per radian per second of 
+             *      the output shaft
+             */
+            double nativePerRadPerSec = 1.0;
+
+            /**
+             * @brief 
+             *      Radians per second of the output shaft per motor controller
+             *      velocity unit; the inverse of nativePerRadPerSec
+             */
+            double radPerSecPerNative = 1.0;
+
+            /**
+             * @brief 
+             *      Motor controller position units per radian of the output 
+             *      shaft
+             */
+            double nativePerRadian = 1.0;
+
+            /**
+             * @brief 
+             *      Radians of the output shaft per motor controller position 
+             *      unit; the inverse of nativePerRadian
+             */
+            double radiansPerNative = 1.0;
+
             /**
              * @brief 
              *      Device ID on the CAN bus; passed into the constructor
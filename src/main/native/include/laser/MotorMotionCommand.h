@@ -63,7 +63,15 @@ namespace commands {
         /** Manual go towards forward limit switch */
         eManualForward, 
         /** Manual go towards reverse limit switch */
-        eManualReverse  
+        eManualReverse,
+        /** Go towards reverse limit switch fast, back off, then go back slowly */
+        eHomeReverseTwoPhase,
+        /** Slowly back off of the reverse limit switch (entered by eHomeReverseTwoPhase) */
+        eHomeBackOff,
+        /** Slowly go towards reverse limit switch (entered by eHomeBackOff) */
+        eHomeReverseSlow,
+        /** Go towards the reverse hard stop until the motor stalls against it */
+        eHomeReverseStall
     }; // enum State
 
     /**
@@ -152,8 +160,66 @@ namespace commands {
              *      command is still executing
              */
             bool IsFinished() override;
+
+            /**
+             * @brief 
+             *      Sets the speed of the slow phases of eHomeReverseTwoPhase; 
+             *      the fast approach uses the homing speed given to the 
+             *      constructor.
+             * 
+             * The fast approach stops as soon as the reverse limit switch 
+             * trips, so overshoot doesn't matter; the slow re-approach is what
+             * sets the zero, so it decides how repeatable homing is. When the
+             * motor controller supports it (see 
+             * MotorMotion::SetClearPositionOnRevLimit()), it zeroes itself 
+             * the moment the switch closes. Otherwise the zero is taken on the
+             * first command cycle that sees the switch, so it can be off by 
+             * the distance traveled at the slow speed in one loop period plus
+             * the limit switch status frame period, e.g. 30 ms at 20 ms and 
+             * 10 ms; lower the slow speed until that is small enough.
+             * @param speed
+             *      The slow homing speed (in percent of max power), with the
+             *      same sign as the homing speed (default a fifth of it)
+             */
+            void SetSlowHomeSpeed(double /* speed */);
+
+            /**
+             * @brief 
+             *      Configures how eHomeReverseStall detects the hard stop.
+             * 
+             * The motor has stalled once its current is at least the stall 
+             * current while its speed is at most the stall velocity, for the
+             * given number of consecutive cycles. Nothing is checked during 
+             * the blanking time at the start, so the inrush current of a 
+             * motor that hasn't sped up yet isn't mistaken for a stall.
+             * @param current
+             *      The lowest current of a stalled motor in units::ampere_t 
+             *      (default 20 A)
+             * @param velocity
+             *      The fastest speed of a stalled motor in 
+             *      units::meters_per_second_t (default 0.02 m/s)
+             * @param cycles
+             *      Number of consecutive cycles the stall has to be seen for
+             *      (default 5)
+             * @param blanking
+             *      Time after the start of homing during which stalls are 
+             *      ignored in units::second_t (default 0.25 s)
+             */
+            void SetStallDetection(
+                units::ampere_t /* current */, 
+                units::meters_per_second_t /* velocity */, 
+                int /* cycles */ = 5, 
+                units::second_t /* blanking */ = 0.25_s
+            );
         
         protected:
+            /**
+             * @brief 
+             *      Stops the motor controller from zeroing itself on the 
+             *      reverse limit switch, if homing turned that on
+             */
+            void ReleaseHardwareZero();
+
             /** @brief State enum type containing the action to be executed by the command */
             State currentState = eIdle;
             /** @brief MotorMotion<...> object pointer to control the physical motor using common commands */
@@ -172,6 +238,21 @@ namespace commands {
             double revHomeSpeed;
             /** @brief A percentage of how fast it should be moving away from home switch */
             double fwdHomeSpeed;
+            /** @brief A percentage of how fast it should be moving towards home switch during the slow phases */
+            double slowHomeSpeed;
+
+            /** @brief The lowest current of a stalled motor */
+            units::ampere_t stallCurrent = 20.0_A;
+            /** @brief The fastest speed of a stalled motor */
+            units::meters_per_second_t stallVelocity = 0.02_mps;
+            /** @brief Number of consecutive cycles a stall has to be seen for */
+            int stallCycles = 5;
+            /** @brief Time after the start of homing during which stalls are ignored */
+            units::second_t stallBlankingTime = 0.25_s;
+            /** @brief Number of consecutive cycles a stall has been seen for so far */
+            int stalledCycles = 0;
+            /** @brief Whether the motor controller zeroes itself when the reverse limit switch closes */
+            bool isHardwareZero = false;
     }; // class MotorMotionCommand
 
     /** @brief A typedef of MotorMotionCommand<...> specifically for TalonFXMotion */
@@ -0,0 +1,252 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MotorMotionGroup.h
+ * @brief 
+ *      This file contains the MotorMotionGroup class, which drives several
+ *      motors on one gearbox through a single leader.
+ * 
+ * Each follower is put in the controller's follower mode, so it mirrors the
+ * leader's output on the controller itself. Setpoints and reads only go to
+ * the leader, which removes both the extra control frames and the skew
+ * between motors that were each sent their own setpoint.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <vector>
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class MotorMotionGroup MotorMotionGroup.h laser/MotorMotionGroup.h
+     * @brief 
+     *      A leader MotorMotion and the followers mirroring its output.
+     * 
+     * The group does not own its motors. Configuration that each controller
+     * applies on its own, such as the current limit, is replicated to every
+     * motor; everything else only goes to the leader, which can be reached
+     * through GetLeader(). Ramp rates are left to the leader, since a ramp on
+     * a follower would only lag it behind.
+     * @tparam ErrorEnum
+     *      The error type of the motor controllers
+     * @tparam MotorType
+     *      The motor controller type; followers must be of the same type as
+     *      the leader
+     */
+    template <typename ErrorEnum, class MotorType>
+    class MotorMotionGroup {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the leader of the group.
+             * @param leader
+             *      MotorMotion object pointer of the leader
+             */
+            MotorMotionGroup(MotorMotion<ErrorEnum, MotorType>* leader) : leader(leader) {}
+
+            /**
+             * @brief 
+             *      Attaches a follower to the leader.
+             * 
+             * The follower stops reading every status frame, since all reads
+             * go to the leader; call SetConsumedSignals() on it afterwards to
+             * keep watching, e.g., its current. The leader's applied output 
+             * frame, which the follower tracks, is pinned to its default 
+             * rate. A follower that fails to follow, including the leader 
+             * itself, is not added and its frames are left alone.
+             * @param follower
+             *      MotorMotion object pointer of the follower
+             * @param isOpposed
+             *      When true, the follower spins opposite to the leader, e.g.
+             *      when mounted on the other side of the gearbox
+             * @return 
+             *      The first error reported while attaching the follower
+             */
+            ErrorEnum AddFollower(MotorMotion<ErrorEnum, MotorType>* follower, bool isOpposed = false) {
+                // Follow() rejects the leader itself without touching it; a 
+                // follower that isn't following must keep its own frames
+                ErrorEnum result = follower->Follow(*leader, isOpposed);
+                if (result != ErrorEnum{}) {
+                    return result;
+                }
+
+                followers.push_back(follower);
+
+                ErrorEnum errors[] = {
+                    follower->SetConsumedSignals(eSignalNone),
+                    leader->PinSignals(eSignalAppliedOutput)
+                };
+                for (ErrorEnum error : errors) {
+                    if (result == ErrorEnum{}) {
+                        result = error;
+                    }
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief 
+             *      Sets the current limit of every motor in the group.
+             * @param amps
+             *      The current limit of each motor in units::ampere_t
+             * @return 
+             *      The first error reported by any of the motors
+             */
+            ErrorEnum ConfigCurrentLimit(units::ampere_t amps) {
+                return ForEach([amps](MotorMotion<ErrorEnum, MotorType>* motion) {
+                    return motion->ConfigCurrentLimit(amps);
+                });
+            }
+
+            /**
+             * @brief 
+             *      Sets the position setpoint of the leader in meters
+             * @param position
+             *      Desired position of the group in units::meter_t
+             */
+            void SetSetpoint(units::meter_t position) { leader->SetSetpoint(position); }
+
+            /**
+             * @brief 
+             *      Sets the linear velocity setpoint of the leader in m/s
+             * @param lvelocity
+             *      Desired linear velocity of the group in
+             *      units::meters_per_second_t
+             */
+            void SetSetpoint(units::meters_per_second_t lvelocity) { leader->SetSetpoint(lvelocity); }
+
+            /**
+             * @brief 
+             *      Sets the angular velocity setpoint of the leader in rad/s
+             * @param avelocity
+             *      Desired angular velocity of the group in
+             *      units::radians_per_second_t
+             */
+            void SetSetpoint(units::radians_per_second_t avelocity) { leader->SetSetpoint(avelocity); }
+
+            /**
+             * @brief 
+             *      Sets the angular position setpoint of the leader in radians
+             * @param angle
+             *      Desired angle of the output shaft in units::radian_t
+             */
+            void SetSetpoint(units::radian_t angle) { leader->SetSetpoint(angle); }
+
+            /**
+             * @brief 
+             *      Sets a profiled position setpoint of the leader in meters
+             * @param position
+             *      Desired position of the group in units::meter_t
+             */
+            void SetProfiledSetpoint(units::meter_t position) { leader->SetProfiledSetpoint(position); }
+
+            /**
+             * @brief 
+             *      Sets the voltage of the leader
+             * @param voltage
+             *      units::volt_t representing the motor voltage in Volts
+             */
+            void SetMotorVoltage(units::volt_t voltage) { leader->SetMotorVoltage(voltage); }
+
+            /**
+             * @brief 
+             *      Halts the leader, and with it the followers
+             */
+            void Stop() { leader->Stop(); }
+
+            /**
+             * @brief 
+             *      Refreshes the state of the leader
+             */
+            void Refresh() { leader->Refresh(); }
+
+            /**
+             * @brief 
+             *      Returns the position of the leader
+             * @return 
+             *      units::meter_t representing the distance traveled in meters
+             */
+            units::meter_t GetActualPosition() { return leader->GetActualPosition(); }
+
+            /**
+             * @brief 
+             *      Returns the linear velocity of the leader
+             * @return 
+             *      units::meters_per_second_t representing the velocity in m/s
+             */
+            units::meters_per_second_t GetActualVelocity() { return leader->GetActualVelocity(); }
+
+            /**
+             * @brief 
+             *      Returns the angular velocity of the leader
+             * @return 
+             *      units::radians_per_second_t representing the angular
+             *      velocity in rad/s
+             */
+            units::radians_per_second_t GetActualAngularVelocity() { return leader->GetActualAngularVelocity(); }
+
+            /**
+             * @brief 
+             *      Returns the leader of the group
+             * @return 
+             *      MotorMotion object pointer of the leader
+             */
+            MotorMotion<ErrorEnum, MotorType>* GetLeader() { return leader; }
+
+            /**
+             * @brief 
+             *      Returns the followers of the group
+             * @return 
+             *      The followers, in the order they were added
+             */
+            const std::vector<MotorMotion<ErrorEnum, MotorType>*>& GetFollowers() { return followers; }
+
+        protected:
+            /**
+             * @brief 
+             *      Applies a configuration call to every motor in the group
+             * @param config
+             *      Callable applying the configuration to one motor
+             * @return 
+             *      The first error reported by any of the motors
+             */
+            template <typename Config>
+            ErrorEnum ForEach(Config config) {
+                ErrorEnum result = config(leader);
+                for (MotorMotion<ErrorEnum, MotorType>* follower : followers) {
+                    ErrorEnum error = config(follower);
+                    if (result == ErrorEnum{}) {
+                        result = error;
+                    }
+                }
+
+                return result;
+            }
+
+            /** @brief The motor receiving setpoints and serving reads */
+            MotorMotion<ErrorEnum, MotorType>* leader;
+            /** @brief The motors mirroring the leader's output */
+            std::vector<MotorMotion<ErrorEnum, MotorType>*> followers;
+    }; // class MotorMotionGroup
+
+} // namespace laser
@@ -0,0 +1,208 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MotorMotionScheduler.h
+ * @brief 
+ *      This file contains the MotorMotionScheduler class, which runs the
+ *      refresh/compute/write cycle of a group of motors on its own high-rate
+ *      thread.
+ * 
+ * By default, everything a MotorMotion does happens wherever user code calls
+ * it, which is usually the 50 Hz TimedRobot periodic. Registering the motors
+ * and the roboRIO-side control loops that drive them with a scheduler runs
+ * them at a faster, fixed rate instead.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <frc/Notifier.h>
+#include <units/time.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @struct SchedulerTiming
+     * @brief 
+     *      Per-cycle timing statistics of a MotorMotionScheduler
+     */
+    struct SchedulerTiming {
+        /** @brief Number of cycles run since the last reset */
+        unsigned long cycles = 0;
+        /** @brief Number of cycles that took longer than the period */
+        unsigned long overruns = 0;
+        /** @brief How long the last cycle took to run */
+        units::second_t lastCycleTime = 0.0_s;
+        /** @brief The longest any cycle took to run */
+        units::second_t maxCycleTime = 0.0_s;
+        /** @brief Time between the starts of the last two cycles */
+        units::second_t lastLoopPeriod = 0.0_s;
+        /** @brief The longest time between the starts of two cycles */
+        units::second_t maxLoopPeriod = 0.0_s;
+    }; // struct SchedulerTiming
+
+    /**
+     * @class MotorMotionScheduler MotorMotionScheduler.h laser/MotorMotionScheduler.h
+     * @brief 
+     *      Runs the refresh/compute/write cycle of its registered motors on a
+     *      frc::Notifier thread at a configurable rate.
+     * 
+     * Every cycle refreshes each registered motor once, then runs each
+     * registered control loop (which computes and writes setpoints) in the
+     * order they were added. Rates of 200 Hz to 1 kHz are typical; the timing
+     * of each cycle is recorded so overruns can be spotted.
+     * @see SchedulerTiming
+     */
+    class MotorMotionScheduler {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the period of the cycle.
+             * 
+             * The scheduler does not run until Start() is called.
+             * @param period
+             *      Time between the starts of two cycles in units::second_t
+             *      (default 5 ms, 200 Hz)
+             * @param priority
+             *      Real-time priority of the scheduler thread, from 1 to 99, 
+             *      applied from its first cycle; when 0 (default), the thread
+             *      keeps its normal priority
+             */
+            MotorMotionScheduler(units::second_t /* period */ = 0.005_s, int /* priority */ = 0);
+
+            /**
+             * @brief 
+             *      Destructor for the class; stops the scheduler thread.
+             */
+            ~MotorMotionScheduler();
+
+            MotorMotionScheduler(const MotorMotionScheduler&) = delete;
+            MotorMotionScheduler& operator=(const MotorMotionScheduler&) = delete;
+
+            /**
+             * @brief 
+             *      Registers a motor to be refreshed at the start of every
+             *      cycle.
+             * 
+             * The scheduler takes over refreshing the motor, so its max state
+             * age is set to zero; getters called from other threads serve the
+             * state captured by the latest cycle.
+             * @param motion
+             *      MotorMotion object pointer of the motor to refresh
+             */
+            template <typename ErrorEnum, class MotorType>
+            void AddMotor(MotorMotion<ErrorEnum, MotorType>* motion) {
+                motion->SetStateMaxAge(0.0_s);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                refreshes.push_back([motion] { motion->Refresh(); });
+            }
+
+            /**
+             * @brief 
+             *      Registers a control loop to run every cycle, after every
+             *      motor has been refreshed.
+             * @param loop
+             *      Callable computing and writing setpoints for one or more
+             *      motors
+             */
+            void AddControlLoop(std::function<void()> /* loop */);
+
+            /**
+             * @brief 
+             *      Starts running cycles at the configured period.
+             */
+            void Start();
+
+            /**
+             * @brief 
+             *      Stops running cycles; the registered motors and control
+             *      loops are kept.
+             */
+            void Stop();
+
+            /**
+             * @brief 
+             *      Sets the time between the starts of two cycles; this takes
+             *      effect on the next call to Start().
+             * @param period
+             *      The period of the cycle in units::second_t
+             */
+            void SetPeriod(units::second_t /* period */);
+
+            /**
+             * @brief 
+             *      Returns the period of the cycle.
+             * @return 
+             *      The period of the cycle in units::second_t
+             */
+            units::second_t GetPeriod();
+
+            /**
+             * @brief 
+             *      Returns the timing statistics of the cycles run so far.
+             * @return 
+             *      A copy of the SchedulerTiming statistics
+             */
+            SchedulerTiming GetTiming();
+
+            /**
+             * @brief 
+             *      Clears the timing statistics.
+             */
+            void ResetTiming();
+
+        protected:
+            /**
+             * @brief 
+             *      Runs a single cycle; this is the callback of the notifier.
+             */
+            void Cycle();
+
+            /** @brief Guards the registered motors and control loops */
+            std::mutex mutex;
+            /** @brief Refresh calls of the registered motors */
+            std::vector<std::function<void()>> refreshes;
+            /** @brief Registered control loops, in order of registration */
+            std::vector<std::function<void()>> controlLoops;
+
+            /** @brief Guards the timing statistics */
+            std::mutex timingMutex;
+            /** @brief Timing statistics of the cycles run so far */
+            SchedulerTiming timing;
+            /** @brief FPGA timestamp of the start of the previous cycle */
+            units::second_t lastCycleStart = 0.0_s;
+
+            /** @brief Time between the starts of two cycles; also read by the notifier thread */
+            std::atomic<units::second_t> period;
+            /** @brief Real-time priority of the scheduler thread; 0 leaves it alone */
+            int threadPriority;
+            /** @brief Whether the thread priority has been applied yet; only touched by the scheduler thread */
+            bool isPriorityApplied = false;
+
+            /** @brief The notifier running Cycle(); declared last so it is destroyed first */
+            frc::Notifier notifier;
+    }; // class MotorMotionScheduler
+
+} // namespace laser
@@ -0,0 +1,140 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file SeqLock.h
+ * @brief 
+ *      This file contains the SeqLock class, which publishes a value from one
+ *      writer to any number of reader threads without locking.
+ * 
+ * MotorMotion publishes its MotorState through a SeqLock so the state can be
+ * read from vision, odometry or dashboard threads while a control thread is
+ * refreshing it.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class SeqLock SeqLock.h laser/SeqLock.h
+     * @brief 
+     *      A sequence lock holding a single trivially copyable value.
+     * 
+     * The writer bumps a sequence counter to an odd number, copies the value
+     * in, then bumps it back to even; it never waits on readers. A reader
+     * copies the value out and retries only if the counter was odd or
+     * changed while it was copying, so it always returns a consistent
+     * snapshot. The value is stored as relaxed atomic words, which keeps the
+     * concurrent copies well-defined.
+     * @warning 
+     *      Store() must only be called from one thread at a time; callers with
+     *      several writers must serialize them.
+     * @tparam T
+     *      The trivially copyable type to publish
+     */
+    template <typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+        public:
+            /**
+             * @brief 
+             *      Constructor that publishes an initial value
+             * @param value
+             *      The value readers see until the first Store()
+             */
+            explicit SeqLock(const T& value = T()) { Write(value); }
+
+            SeqLock(const SeqLock&) = delete;
+            SeqLock& operator=(const SeqLock&) = delete;
+
+            /**
+             * @brief 
+             *      Publishes a new value; never blocks
+             * @param value
+             *      The value to publish
+             */
+            void Store(const T& value) {
+                std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+
+                sequence.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                Write(value);
+
+                sequence.store(seq + 2, std::memory_order_release);
+            }
+
+            /**
+             * @brief 
+             *      Returns a consistent copy of the latest published value
+             * @return 
+             *      The value passed to the most recent Store()
+             */
+            T Load() const {
+                std::uint64_t buffer[wordCount];
+                std::uint64_t before;
+                std::uint64_t after;
+
+                do {
+                    before = sequence.load(std::memory_order_acquire);
+                    for (std::size_t i = 0; i < wordCount; i++) {
+                        buffer[i] = words[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    after = sequence.load(std::memory_order_relaxed);
+                } while ((before & 1) || before != after);
+
+                T value;
+                std::memcpy(&value, buffer, sizeof(T));
+                return value;
+            }
+
+        private:
+            /**
+             * @brief 
+             *      Copies a value into the atomic words
+             * @param value
+             *      The value to copy in
+             */
+            void Write(const T& value) {
+                std::uint64_t buffer[wordCount] = {};
+                std::memcpy(buffer, &value, sizeof(T));
+                for (std::size_t i = 0; i < wordCount; i++) {
+                    words[i].store(buffer[i], std::memory_order_relaxed);
+                }
+            }
+
+            /** @brief Number of 64-bit words needed to hold a T */
+            static constexpr std::size_t wordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+            /** @brief Even while the value is stable, odd while a Store() is in progress */
+            std::atomic<std::uint64_t> sequence{0};
+            /** @brief The published value, as relaxed atomic words */
+            std::atomic<std::uint64_t> words[wordCount];
+    }; // class SeqLock
+
+} // namespace laser
@@ -0,0 +1,213 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file SimulationHarness.h
+ * @brief 
+ *      This file contains the SimulationHarness class, which steps simulated
+ *      MotorMotion mechanisms and commands in fixed time steps.
+ * @see MechanismSim.h
+ */
+#pragma once
+
+#include <frc2/command/Command.h>
+#include <units/time.h>
+#include <functional>
+#include <vector>
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+namespace simulation {
+
+    /**
+     * @class SimulationHarness SimulationHarness.h laser/SimulationHarness.h
+     * @brief 
+     *      Runs a simulation by pausing the HAL clock and advancing it by a
+     *      fixed step at a time.
+     * 
+     * Every step runs, in order: the registered control loops, the Execute()
+     * of every running command (calling End() on those that finish), the HAL
+     * clock, and finally the attached mechanism of every registered motor.
+     * frc::Timer and the FPGA timestamp only move when the harness steps, so
+     * timeouts and the MotorState timestamps follow simulated time.
+     * 
+     * Registered motors are plant driven (see MotorMotion::SetPlantDriven()):
+     * their mechanisms run on the voltage commanded on the roboRIO and are 
+     * read back directly, then the motors are refreshed, so their listeners
+     * fire within the step. Nothing then depends on the wall clock, so runs 
+     * repeat bit for bit and step as fast as the host allows. Close the loop
+     * on the roboRIO, e.g. with a control loop calling SetMotorVoltage().
+     * @warning 
+     *      A motor registered without plant driving runs through the 
+     *      vendor's simulated firmware, which has its own wall-clock thread 
+     *      that the harness cannot step; its runs are not bit-identical, and 
+     *      stepping faster than real time leaves its mechanism reading stale
+     *      outputs.
+     */
+    class SimulationHarness {
+        public:
+            /**
+             * @brief 
+             *      Constructor that pauses the HAL clock and enables the robot.
+             * @param step
+             *      The fixed time step in units::second_t (default 5 ms)
+             */
+            SimulationHarness(units::second_t /* step */ = 0.005_s);
+
+            /**
+             * @brief 
+             *      Destructor for the class; disables the robot and resumes
+             *      the HAL clock.
+             */
+            ~SimulationHarness();
+
+            SimulationHarness(const SimulationHarness&) = delete;
+            SimulationHarness& operator=(const SimulationHarness&) = delete;
+
+            /**
+             * @brief 
+             *      Registers a motor whose attached mechanism is stepped every
+             *      step
+             * @param motion
+             *      MotorMotion object pointer with a mechanism attached
+             * @param isPlantDriven
+             *      When true (the default), the mechanism is driven from the 
+             *      roboRIO and the motor is refreshed every step; when false,
+             *      it runs through the simulated motor controller, e.g. to 
+             *      exercise an on-controller closed loop
+             */
+            template <typename ErrorEnum, class MotorType>
+            void AddMotor(MotorMotion<ErrorEnum, MotorType>* motion, bool isPlantDriven = true) {
+                motion->SetPlantDriven(isPlantDriven);
+                motors.push_back([motion](units::second_t dt) {
+                    motion->SimulationPeriodic(dt);
+                    if (motion->IsPlantDriven()) {
+                        motion->Refresh();
+                    }
+                });
+            }
+
+            /**
+             * @brief 
+             *      Registers a control loop to run at the start of every step
+             * @param loop
+             *      Callable computing and writing setpoints
+             */
+            void AddControlLoop(std::function<void()> /* loop */);
+
+            /**
+             * @brief 
+             *      Schedules a command; it is initialized on the next step and
+             *      executed every step until it finishes
+             * @param command
+             *      The command to run, e.g. a MotorMotionCommand; it is not
+             *      owned by the harness
+             */
+            void Schedule(frc2::Command* /* command */);
+
+            /**
+             * @brief 
+             *      Returns whether a command scheduled on the harness is still
+             *      running
+             * @param command
+             *      The command to check
+             * @return 
+             *      True while the command has not finished
+             */
+            bool IsScheduled(frc2::Command* /* command */);
+
+            /**
+             * @brief 
+             *      Runs a single fixed time step
+             */
+            void Step();
+
+            /**
+             * @brief 
+             *      Runs fixed time steps until the given simulated duration
+             *      has passed
+             * @param duration
+             *      The simulated time to run for in units::second_t
+             */
+            void Run(units::second_t /* duration */);
+
+            /**
+             * @brief 
+             *      Runs fixed time steps until a condition is met or the
+             *      timeout passes
+             * @param condition
+             *      Checked after every step
+             * @param timeout
+             *      The longest simulated time to run for in units::second_t
+             * @return 
+             *      True if the condition was met before the timeout
+             */
+            bool RunUntil(std::function<bool()> /* condition */, units::second_t /* timeout */);
+
+            /**
+             * @brief 
+             *      Enables or disables the simulated robot
+             * @param isEnabled
+             *      When true, the robot is enabled
+             */
+            void SetEnabled(bool /* isEnabled */);
+
+            /**
+             * @brief 
+             *      Returns the simulated time since the harness was created
+             * @return 
+             *      The simulated time in units::second_t
+             */
+            units::second_t GetTime();
+
+            /**
+             * @brief 
+             *      Returns the fixed time step
+             * @return 
+             *      The time step in units::second_t
+             */
+            units::second_t GetStep();
+
+        protected:
+            /**
+             * @brief 
+             *      A command run by the harness, and whether it has been
+             *      initialized yet
+             */
+            struct ScheduledCommand {
+                frc2::Command* command;
+                bool isInitialized;
+            };
+
+            /** @brief The fixed time step */
+            units::second_t step;
+            /** @brief Number of steps run so far; the time is derived from this to avoid drift */
+            long steps = 0;
+            /** @brief SimulationPeriodic() calls of the registered motors */
+            std::vector<std::function<void(units::second_t)>> motors;
+            /** @brief Registered control loops, in order of registration */
+            std::vector<std::function<void()>> controlLoops;
+            /** @brief Commands that have not finished yet, in order of scheduling */
+            std::vector<ScheduledCommand> commands;
+    }; // class SimulationHarness
+
+} // namespace simulation
+
+} // namespace laser
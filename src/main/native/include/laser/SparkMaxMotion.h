@@ -21,13 +21,16 @@ with MotorMotion. If not, see <https://www.gnu.org/licenses/>.
  * @brief 
  *      This file contains the declaration of the SparkMaxMotion class, which 
  *      implements MotorMotion for CAN Spark Max
- * @todo 
- *      Implement SparkMaxMotion
  */
 #pragma once
 
 #include <rev/CANSparkMax.h>
+#include <rev/SparkMaxLimitSwitch.h>
+#include <rev/SparkMaxPIDController.h>
+#include <rev/SparkMaxRelativeEncoder.h>
+#include <units/time.h>
 #include "laser/MotorMotion.h"
+#include "laser/StaticMotorMotion.h"
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace laser {
@@ -43,25 +46,690 @@ namespace sparkmax {
      * @brief 
      *      This namespace is meant to contain defaults and constants for the 
      *      SparkMaxMotion class implementation
-     * @todo 
-     *      Fill in based on SparkMaxMotion implementation
+     * 
+     * This includes the counts per revolution of the NEO's hall sensor and 
+     * the PID slots used by each setpoint type.
      */
     namespace defaults {
-        
-    }
+        /**
+         * @brief 
+         *      The number of sensor units per revolution of the input shaft.
+         * 
+         * The NEO and NEO 550 hall sensors, read by the Spark Max as its 
+         * relative encoder, have a CPR of 42.
+         */
+        constexpr double countsPerRev = 42.0;
+
+        /**
+         * @brief 
+         *      The PID slot holding the gains for position setpoints.
+         * 
+         * Each setpoint type has its own slot on the Spark Max, so switching 
+         * between them never rewrites the gains.
+         */
+        constexpr int positionSlot = 0;
+
+        /**
+         * @brief 
+         *      The PID slot holding the gains for linear velocity setpoints.
+         */
+        constexpr int linearVelocitySlot = 1;
+
+        /**
+         * @brief 
+         *      The PID slot holding the gains for angular velocity setpoints.
+         */
+        constexpr int angularVelocitySlot = 2;
+
+        /**
+         * @brief 
+         *      The PID slot holding the gains and Smart Motion constraints for
+         *      profiled position setpoints.
+         */
+        constexpr int profiledPositionSlot = 3;
+
+        /**
+         * @brief 
+         *      The smart current limit used when the current limit is 
+         *      disabled; this is the Spark Max's factory default.
+         */
+        constexpr unsigned int defaultCurrentLimit = 80;
+
+        /**
+         * @brief 
+         *      The period status frames are slowed down to when none of their
+         *      signals are consumed.
+         */
+        constexpr units::millisecond_t slowFramePeriod = 500.0_ms;
+
+        /**
+         * @brief 
+         *      A periodic status frame of the Spark Max, its factory default
+         *      period and the signals it carries.
+         */
+        struct StatusFrameDefault {
+            /** @brief The periodic status frame */
+            rev::CANSparkMaxLowLevel::PeriodicFrame frame;
+            /** @brief The factory default period of the frame */
+            units::millisecond_t period;
+            /** @brief Bitmask of the Signal values the frame carries */
+            int signals;
+        };
+
+        /**
+         * @brief 
+         *      Every periodic status frame the Spark Max sends, with its 
+         *      factory default period.
+         * 
+         * Status 0 carries the applied output, faults and limit switches, 
+         * Status 1 the velocity, current and bus voltage, and Status 2 the 
+         * position; the rest carry sensors MotorMotion doesn't read.
+         */
+        constexpr StatusFrameDefault statusFrames[] = {
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus0, 10.0_ms, eSignalLimitSwitches | eSignalFaults | eSignalAppliedOutput },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus1, 20.0_ms, eSignalVelocity | eSignalCurrent },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus2, 20.0_ms, eSignalPosition },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus3, 50.0_ms, eSignalNone },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus4, 20.0_ms, eSignalNone },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus5, 200.0_ms, eSignalNone },
+            { rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus6, 200.0_ms, eSignalNone }
+        };
+    } // namespace defaults
 
     /**
      * @class SparkMaxMotion SparkMaxMotion.h laser/SparkMaxMotion.h
      * @brief 
      *      This is the declaration of the SparkMaxMotion class, which
-     *      implements MotorMotion
-     * @todo 
-     *      Inherit MotorMotion<rev::REVLibError, rev::CANSparkMax>
+     *      implements MotorMotion.
+     * 
+     * This implementation uses REVLib to control NEO/NEO 550 motors through a
+     * CAN Spark Max. The gear ratio and wheel diameter are written to the 
+     * Spark Max's relative encoder as conversion factors, so the controller 
+     * itself reports and controls in meters and m/s; angular velocities are 
+     * converted through the wheel radius.
+     * 
+     * Every value read by Refresh() comes from a periodic status frame the 
+     * Spark Max broadcasts, so the reads never wait on the CAN bus, and the 
+     * max state age follows the feedback frame periods so the getters never 
+     * refresh faster than new data can arrive.
+     * @see MotorMotion
+     * @see StaticMotorMotion
      */
-    class SparkMaxMotion {
-        
-    };
+    class SparkMaxMotion : 
+        public MotorMotion<rev::REVLibError, rev::CANSparkMax>,
+        public StaticMotorMotion<SparkMaxMotion> 
+    {
+        public:
+            /**
+             * @brief 
+             *      Constructor that accepts the device ID on the CAN bus.
+             * 
+             * The Spark Max is driven as a brushless controller. The defaults 
+             * for the gear ratio and wheel diameter are 1.0 (1.0_m for the 
+             * diameter of the wheel), which allows 1:1 systems that just care
+             * about rotational speed to ignore the wheel diameter.
+             * @param deviceID
+             *      The ID on the CAN bus to use for the Spark Max
+             * @param ratio
+             *      The gear ratio to be used for the encoder conversion 
+             *      factors (input:output)
+             * @param diameter
+             *      The wheel diameter in meters to be used for the encoder 
+             *      conversion factors
+             */
+            SparkMaxMotion(int /* deviceID */, double /* gearing */ = 1.0, units::meter_t /* diameter */ = 1.0_m);
+
+            /**
+             * @brief 
+             *      Destructor for the class; deletes any stray pointers.
+             * 
+             * Any queued async configuration writes are waited on first.
+             */
+            ~SparkMaxMotion();
+
+            /**
+             * @brief 
+             *      Configure whether limit switches are NO or NC.
+             * 
+             * By default, both limit switches are Normally Open (NO). The 
+             * Spark Max sets the polarity when the limit switch object is 
+             * created, so this should be called while setting up the robot 
+             * rather than while another thread is reading the motor.
+             * @param isFwdNO
+             *      When true, the Forward Limit Switch will be treated as 
+             *      Normally Open
+             * @param isRevNO
+             *      When true, the Reverse Limit Switch will be treated as 
+             *      Normally Open
+             */
+            void ConfigLimitSwitches(bool /* isFwdNO */, bool /* isRevNO */) override;
+
+            /**
+             * @brief 
+             *      Configure the smart current limit (in Amps) of the motor.
+             * 
+             * A limit of 0 A restores the Spark Max's default limit of 80 A.
+             * @param amps
+             *      The amperage limit of the motor in units::ampere_t
+             * @return 
+             *      The error reported by the motor controller; in async 
+             *      configuration mode this is reported through GetLastError()
+             *      instead
+             */
+            rev::REVLibError ConfigCurrentLimit(units::ampere_t /* amps */) override;
+
+            /**
+             * @brief 
+             *      Halts the motor as quickly as the open-loop ramp rate allows.
+             */
+            void Stop() override;
+
+            /**
+             * @brief 
+             *      Returns the position the motor has traveled, as reported by
+             *      the Spark Max in meters
+             * @return 
+             *      units::meter_t representing the distance traveled in meters
+             */
+            units::meter_t GetActualPosition() override { return Snapshot().position; }
+
+            /**
+             * @brief 
+             *      Returns the velocity the wheel is currently spinning at, as
+             *      reported by the Spark Max in meters per second
+             * @return 
+             *      units::meters_per_second_t representing the velocity in m/s
+             */
+            units::meters_per_second_t GetActualVelocity() override { return Snapshot().velocity; }
+
+            /**
+             * @brief 
+             *      Returns the angular velocity the output shaft is currently
+             *      spinning at in radians per second
+             * @return 
+             *      units::radians_per_second_t representing the angular 
+             *      velocity in rad/s
+             */
+            units::radians_per_second_t GetActualAngularVelocity() override { return Snapshot().angularVelocity; }
+
+            /**
+             * @brief 
+             *      Returns the maximum tolerance of the position setpoint
+             * @return 
+             *      The maximum tolerance in units::meter_t
+             */
+            units::meter_t GetPositionTolerance() override;
+
+            /**
+             * @brief 
+             *      Returns the maximum tolerance of the linear velocity 
+             *      setpoint
+             * @return 
+             *      The maximum tolerance in units::meters_per_second_t
+             */
+            units::meters_per_second_t GetVelocityTolerance() override;
+
+            /**
+             * @brief 
+             *      Returns the maximum tolerance of the angular velocity 
+             *      setpoint
+             * @return 
+             *      The maximum tolerance in units::radians_per_second_t
+             */
+            units::radians_per_second_t GetAngularVelocityTolerance() override;
+
+            /**
+             * @brief 
+             *      Returns the maximum tolerance of the angular position 
+             *      setpoint
+             * @return 
+             *      The maximum tolerance in units::radian_t
+             */
+            units::radian_t GetAngularPositionTolerance() override;
+
+            /**
+             * @brief 
+             *      Sets whether the motor is to spin opposite of the default
+             *      direction.
+             * @param isInverted
+             *      When true, the motor is to be inverted
+             */
+            void SetMotorInverted(bool /* isInverted */) override;
+
+            /**
+             * @brief 
+             *      Sets the PIDF values for the slot of the active setpoint 
+             *      type, or for every slot if no setpoint has been used yet.
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            void SetPIDValues(
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            ) override;
+
+            /**
+             * @brief 
+             *      Sets the PIDF values for the slot of a specific setpoint 
+             *      type.
+             * 
+             * The gains act on the converted units, i.e. meters for position
+             * and m/s for both velocity types.
+             * @param type
+             *      The setpoint type whose PID values should be set
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            void SetPIDValues(
+                SetpointType /* type */,
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            ) override;
+
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the position setpoint.
+             * 
+             * The Spark Max only enforces an allowed error for Smart Motion,
+             * so this is written to the profiled position slot; plain 
+             * position setpoints only report it.
+             * @param tolerance
+             *      The maximum tolerance in units::meter_t
+             */
+            void SetTolerance(units::meter_t /* tolerance */) override;
+
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the linear velocity setpoint;
+             *      the Spark Max has no allowed error for velocity control, so
+             *      this is only recorded.
+             * @param tolerance
+             *      The maximum tolerance in units::meters_per_second_t
+             */
+            void SetTolerance(units::meters_per_second_t /* tolerance */) override;
+
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the angular velocity 
+             *      setpoint; the Spark Max has no allowed error for velocity 
+             *      control, so this is only recorded.
+             * @param tolerance
+             *      The maximum tolerance in units::radians_per_second_t
+             */
+            void SetTolerance(units::radians_per_second_t /* tolerance */) override;
+
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the angular position 
+             *      setpoint; the Spark Max has no allowed error for position
+             *      control, so this is only recorded.
+             * @param tolerance
+             *      The maximum tolerance in units::radian_t
+             */
+            void SetTolerance(units::radian_t /* tolerance */) override;
+
+            /**
+             * @brief 
+             *      Returns the motor voltage, computed from the applied output
+             *      and the bus voltage
+             * @return 
+             *      units::volt_t representing the motor voltage in Volts
+             */
+            units::volt_t GetMotorVoltage() override { return Snapshot().voltage; }
+
+            /**
+             * @brief 
+             *      Sets the motor voltage
+             * @param voltage
+             *      units::volt_t representing the motor voltage in Volts
+             */
+            void SetMotorVoltage(units::volt_t /* voltage */) override;
+
+            /**
+             * @brief 
+             *      Returns the motor amperage
+             * @return 
+             *      units::ampere_t representing the motor amperage in Amperes
+             */
+            units::ampere_t GetMotorCurrent() override { return Snapshot().current; }
+
+            /**
+             * @brief 
+             *      Returns the number of hall sensor counts that have been 
+             *      traveled, derived from the converted position
+             * @return 
+             *      Integer value representing the number of encoder counts
+             */
+            int GetRawEncoderCounts() override { return Snapshot().rawEncoderCounts; }
+
+            /**
+             * @brief 
+             *      Sets the amount of time the motor is allowed to use to 
+             *      reach a closed loop setpoint
+             * @param time
+             *      The time from neutral to full output in units::second_t
+             */
+            void SetClosedRampRate(units::second_t /* time */) override;
+
+            /**
+             * @brief 
+             *      Sets the amount of time the motor is allowed to use to 
+             *      reach an open loop output
+             * @param time
+             *      The time from neutral to full output in units::second_t
+             */
+            void SetOpenRampRate(units::second_t /* time */) override;
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the position of the motor in meters.
+             * @param position
+             *      Desired position of the motor in units::meter_t
+             */
+            void SetSetpoint(units::meter_t /* position */) override;
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the linear velocity of the motor in 
+             *      m/s.
+             * @param lvelocity
+             *      Desired linear velocity of the motor in 
+             *      units::meters_per_second_t
+             */
+            void SetSetpoint(units::meters_per_second_t /* lvelocity */) override;
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the angular velocity of the motor in
+             *      rad/s; it is converted to m/s through the wheel radius.
+             * @param avelocity
+             *      Desired angular velocity of the motor in 
+             *      units::radians_per_second_t
+             */
+            void SetSetpoint(units::radians_per_second_t /* avelocity */) override;
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the angle of the output shaft in 
+             *      radians; it is converted to meters through the wheel radius
+             *      and reached through the position slot. With continuous 
+             *      input, the shortest rotation to an equivalent angle is 
+             *      taken.
+             * 
+             * The Spark Max's encoder counts meters at the wheel, so angles 
+             * need a nonzero wheel diameter, even on a mechanism without a 
+             * wheel.
+             * @param angle
+             *      Desired angle of the output shaft in units::radian_t
+             * @see SetContinuousInput()
+             */
+            void SetSetpoint(units::radian_t /* angle */) override;
+
+            /**
+             * @brief 
+             *      Sets the Smart Motion constraints used by profiled position
+             *      setpoints.
+             * 
+             * Smart Motion only generates trapezoidal profiles, so the S-curve
+             * strength is ignored.
+             * @param maxVelocity
+             *      The cruise velocity of the profile in 
+             *      units::meters_per_second_t
+             * @param maxAcceleration
+             *      The acceleration of the profile in 
+             *      units::meters_per_second_squared_t
+             * @param sCurveStrength
+             *      Unused
+             */
+            void SetMotionConstraints(
+                units::meters_per_second_t /* maxVelocity */, 
+                units::meters_per_second_squared_t /* maxAcceleration */, 
+                int /* sCurveStrength */
+            ) override;
+
+            /**
+             * @brief 
+             *      Sets a position setpoint in meters that is reached through 
+             *      Smart Motion, the Spark Max's on-controller motion profile.
+             * @param position
+             *      Desired position of the motor in units::meter_t
+             */
+            void SetProfiledSetpoint(units::meter_t /* position */) override;
+
+            /**
+             * @brief 
+             *      Streamed trajectories are not supported by the Spark Max.
+             * @param points
+             *      Unused
+             * @return 
+             *      rev::REVLibError::kNotImplemented
+             */
+            rev::REVLibError StartTrajectory(std::span<const TrajectoryPoint> /* points */) override;
+
+            /**
+             * @brief 
+             *      Streamed trajectories are not supported by the Spark Max.
+             * @return 
+             *      An empty TrajectoryProgress
+             */
+            TrajectoryProgress GetTrajectoryProgress() override;
+
+            /**
+             * @brief 
+             *      Sets the integral zone of every slot.
+             * @param izone
+             *      Desired IZone left as a primitive double, in the same 
+             *      units as TalonFXMotion::SetAccumIZone(); it is converted 
+             *      to meters for the Spark Max
+             */
+            void SetAccumIZone(double /* izone */) override;
+
+            /**
+             * @brief 
+             *      Sets and enables the soft limits of the Spark Max; passing 
+             *      equal values disables them, and limits given in the wrong 
+             *      order are swapped.
+             * @param minpos
+             *      The reverse soft limit in units::meter_t
+             * @param maxpos
+             *      The forward soft limit in units::meter_t
+             */
+            void SetPositionSoftLimits(units::meter_t /* minpos */, units::meter_t /* maxpos */) override;
+
+            /**
+             * @brief 
+             *      Not supported; the Spark Max can't clear its position from
+             *      a limit switch, so homing zeroes it from the roboRIO.
+             * @return 
+             *      rev::REVLibError::kNotImplemented
+             */
+            rev::REVLibError SetClearPositionOnRevLimit(bool /* isEnabled */) override;
+
+            /**
+             * @brief 
+             *      Returns the state of the reverse limit switch
+             * @return 
+             *      Boolean value, true = pressed, false = unpressed
+             */
+            bool IsRevLimitSwitchPressed() override { return Snapshot().isRevLimitSwitchPressed; }
+
+            /**
+             * @brief 
+             *      Returns the state of the forward limit switch
+             * @return 
+             *      Boolean value, true = pressed, false = unpressed
+             */
+            bool IsFwdLimitSwitchPressed() override { return Snapshot().isFwdLimitSwitchPressed; }
+
+            /**
+             * @brief 
+             *      Stops the motor and resets the encoder to 0, or seeds it 
+             *      from the absolute sensor when one is attached.
+             */
+            void Reset() override;
+
+            /**
+             * @brief 
+             *      Reads every signal from the Spark Max once and stores it in
+             *      the cached MotorState.
+             * 
+             * Every value comes from the latest periodic status frame, so 
+             * this never waits on the CAN bus.
+             * @see SetPeriodicFramePeriod()
+             */
+            void Refresh() override;
+
+            /**
+             * @brief 
+             *      Steps the attached mechanism using the Spark Max's applied 
+             *      output and writes the result into its simulated device.
+             * @param dt
+             *      The length of the time step in units::second_t
+             * @see AttachSimulation()
+             */
+            void SimulationPeriodic(units::second_t /* dt */) override;
+
+            /**
+             * @brief 
+             *      Makes this Spark Max follow another one.
+             * @param leader
+             *      The SparkMaxMotion object to follow
+             * @param isOpposed
+             *      When true, the output is reversed relative to the leader
+             * @return 
+             *      The error reported by the motor controller
+             */
+            rev::REVLibError Follow(MotorMotion& /* leader */, bool /* isOpposed */) override;
+
+            /**
+             * @brief 
+             *      Sets how often the Spark Max broadcasts a periodic status 
+             *      frame.
+             * 
+             * Slower frames free up CAN bandwidth at the cost of staler 
+             * reads: Status 0 carries the applied output and limit switches, 
+             * Status 1 the velocity and current, and Status 2 the position. 
+             * The max state age follows the faster of Status 1 and 2, unless 
+             * it has been set to zero.
+             * @param frame
+             *      The periodic status frame to configure
+             * @param period
+             *      The period of the frame in units::millisecond_t
+             * @return 
+             *      The error reported by the motor controller
+             */
+            rev::REVLibError SetPeriodicFramePeriod(rev::CANSparkMaxLowLevel::PeriodicFrame /* frame */, units::millisecond_t /* period */);
+
+        protected:
+            /**
+             * @brief 
+             *      Runs the periodic status frames carrying the consumed 
+             *      signals at their default rates and slows every other one 
+             *      down.
+             * 
+             * Velocity and current share Status 1, and the limit switches and
+             * faults share Status 0.
+             * @param signals
+             *      A bitmask of Signal values
+             * @return 
+             *      The first error reported while setting the frame periods
+             * @see defaults::statusFrames
+             */
+            rev::REVLibError ApplySignalFrames(int /* signals */) override;
+
+            /**
+             * @brief 
+             *      Reads every signal Refresh() publishes from the Spark Max;
+             *      called while holding the refresh mutex.
+             * @return 
+             *      The measured state, without setpoints
+             */
+            MotorState ReadSensors();
+
+            /**
+             * @brief 
+             *      Writes the encoder conversion factors for the current gear
+             *      ratio and wheel diameter.
+             * 
+             * After this, the Spark Max reports and controls in meters and 
+             * m/s, so only the rad/s factors and the integral zone depend on 
+             * the factors on this side.
+             */
+            void UpdateConversionFactors() override;
+
+            /**
+             * @brief 
+             *      Writes PIDF gains into a slot through the shadow 
+             *      configuration cache.
+             * @param slot
+             *      The PID slot to write
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            void ConfigSlot(
+                int /* slot */,
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            );
+
+            /**
+             * @brief 
+             *      The Spark Max's relative encoder (the NEO's hall sensor).
+             */
+            rev::SparkMaxRelativeEncoder* encoder;
+
+            /**
+             * @brief 
+             *      The Spark Max's closed loop controller.
+             */
+            rev::SparkMaxPIDController* pidController;
+
+            /**
+             * @brief 
+             *      The forward limit switch, created with the configured 
+             *      polarity.
+             */
+            rev::SparkMaxLimitSwitch* fwdLimitSwitch;
+
+            /**
+             * @brief 
+             *      The reverse limit switch, created with the configured 
+             *      polarity.
+             */
+            rev::SparkMaxLimitSwitch* revLimitSwitch;
+
+            /**
+             * @brief 
+             *      Meters traveled per revolution of the motor shaft; the 
+             *      position conversion factor.
+             */
+            double metersPerMotorRev = 1.0;
+    }; // class SparkMaxMotion
 
 } // namespace sparkmax
 
-} // namespace laser
\ No newline at end of file
+} // namespace laser
@@ -0,0 +1,203 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file StaticMotorMotion.h
+ * @brief 
+ *      This file contains the StaticMotorMotion class, a statically
+ *      dispatched (CRTP) counterpart to the virtual MotorMotion interface.
+ * 
+ * Code that is written against a concrete MotorMotion derived class, rather
+ * than a MotorMotion pointer, can take a StaticMotorMotion reference instead;
+ * every call is then bound at compile time and can be inlined. The virtual
+ * MotorMotion interface is still there for heterogeneous containers.
+ * @see MotorMotion.h
+ * @see TalonFXMotion.h
+ */
+#pragma once
+
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class StaticMotorMotion StaticMotorMotion.h laser/StaticMotorMotion.h
+     * @brief 
+     *      A CRTP base that forwards the hot path of MotorMotion to Derived
+     *      without going through the vtable.
+     * 
+     * Each method calls the Derived implementation through a qualified name,
+     * which suppresses virtual dispatch. Derived classes inherit this
+     * alongside MotorMotion, e.g.
+     * `class TalonFXMotion : public MotorMotion<...>, public StaticMotorMotion<TalonFXMotion>`,
+     * and must implement every method forwarded here.
+     * @tparam Derived
+     *      The MotorMotion derived class inheriting this class
+     * @see MotorMotion
+     */
+    template <class Derived>
+    class StaticMotorMotion {
+        public:
+            /**
+             * @brief 
+             *      Reads every signal from the motor controller once and
+             *      stores it in the cached MotorState
+             */
+            void Refresh() { Self().Derived::Refresh(); }
+
+            /**
+             * @brief 
+             *      Returns the position the motor has traveled based on
+             *      encoder counts
+             * @return 
+             *      units::meter_t representing the distance traveled in meters
+             */
+            units::meter_t GetActualPosition() { return Self().Derived::GetActualPosition(); }
+
+            /**
+             * @brief 
+             *      Returns the velocity the wheel is currently spinning at in
+             *      meters per second
+             * @return 
+             *      units::meters_per_second_t representing the velocity in m/s
+             */
+            units::meters_per_second_t GetActualVelocity() { return Self().Derived::GetActualVelocity(); }
+
+            /**
+             * @brief 
+             *      Returns the angular velocity the output shaft is currently
+             *      spinning at in radians per second
+             * @return 
+             *      units::radians_per_second_t representing the angular
+             *      velocity in rad/s
+             */
+            units::radians_per_second_t GetActualAngularVelocity() { return Self().Derived::GetActualAngularVelocity(); }
+
+            /**
+             * @brief 
+             *      Returns the motor amperage
+             * @return 
+             *      units::ampere_t representing the motor amperage in Amperes
+             */
+            units::ampere_t GetMotorCurrent() { return Self().Derived::GetMotorCurrent(); }
+
+            /**
+             * @brief 
+             *      Returns the motor voltage
+             * @return 
+             *      units::volt_t representing the motor voltage in Volts
+             */
+            units::volt_t GetMotorVoltage() { return Self().Derived::GetMotorVoltage(); }
+
+            /**
+             * @brief 
+             *      Returns the raw number of encoder counts that have been
+             *      traveled
+             * @return 
+             *      Integer value representing the number of encoder counts
+             */
+            int GetRawEncoderCounts() { return Self().Derived::GetRawEncoderCounts(); }
+
+            /**
+             * @brief 
+             *      Returns the state of the forward limit switch
+             * @return 
+             *      Boolean value, true = pressed, false = unpressed
+             */
+            bool IsFwdLimitSwitchPressed() { return Self().Derived::IsFwdLimitSwitchPressed(); }
+
+            /**
+             * @brief 
+             *      Returns the state of the reverse limit switch
+             * @return 
+             *      Boolean value, true = pressed, false = unpressed
+             */
+            bool IsRevLimitSwitchPressed() { return Self().Derived::IsRevLimitSwitchPressed(); }
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the position of the motor in meters
+             * @param position
+             *      Desired position of the motor in units::meter_t
+             */
+            void SetSetpoint(units::meter_t position) { Self().Derived::SetSetpoint(position); }
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the linear velocity of the motor in
+             *      m/s
+             * @param lvelocity
+             *      Desired linear velocity of the motor in
+             *      units::meters_per_second_t
+             */
+            void SetSetpoint(units::meters_per_second_t lvelocity) { Self().Derived::SetSetpoint(lvelocity); }
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the angular velocity of the motor in
+             *      rad/s
+             * @param avelocity
+             *      Desired angular velocity of the motor in
+             *      units::radians_per_second_t
+             */
+            void SetSetpoint(units::radians_per_second_t avelocity) { Self().Derived::SetSetpoint(avelocity); }
+
+            /**
+             * @brief 
+             *      Sets the setpoint for the angle of the output shaft in
+             *      radians
+             * @param angle
+             *      Desired angle of the output shaft in units::radian_t
+             */
+            void SetSetpoint(units::radian_t angle) { Self().Derived::SetSetpoint(angle); }
+
+            /**
+             * @brief 
+             *      Sets a position setpoint in meters that is reached through 
+             *      the on-controller motion profile
+             * @param position
+             *      Desired position of the motor in units::meter_t
+             */
+            void SetProfiledSetpoint(units::meter_t position) { Self().Derived::SetProfiledSetpoint(position); }
+
+            /**
+             * @brief 
+             *      Sets the motor voltage
+             * @param voltage
+             *      units::volt_t representing the motor voltage in Volts
+             */
+            void SetMotorVoltage(units::volt_t voltage) { Self().Derived::SetMotorVoltage(voltage); }
+
+            /**
+             * @brief 
+             *      Halts the motor as quickly as the open-loop ramp rate allows
+             */
+            void Stop() { Self().Derived::Stop(); }
+
+        protected:
+            /**
+             * @brief 
+             *      Returns this object as the Derived class
+             * @return 
+             *      Reference to the Derived object
+             */
+            Derived& Self() { return static_cast<Derived&>(*this); }
+    }; // class StaticMotorMotion
+
+} // namespace laser
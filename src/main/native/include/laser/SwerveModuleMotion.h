@@ -0,0 +1,208 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file SwerveModuleMotion.h
+ * @brief 
+ *      This file contains the SwerveModuleMotion class, which drives a swerve
+ *      module through a drive and a steer MotorMotion.
+ * 
+ * The module takes frc::SwerveModuleState targets directly and handles the
+ * angle optimization, cosine scaling and unit conversions that would otherwise
+ * live in robot code.
+ * @see MotorMotion.h
+ */
+#pragma once
+
+#include <frc/kinematics/SwerveModulePosition.h>
+#include <frc/kinematics/SwerveModuleState.h>
+#include <wpi/array.h>
+#include <ctre/phoenix/motorcontrol/can/WPI_TalonFX.h>
+#include <rev/CANSparkMax.h>
+#include <array>
+#include <memory>
+#include "laser/MotorMotion.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace laser {
+
+    /**
+     * @class SwerveModuleMotion SwerveModuleMotion.h laser/SwerveModuleMotion.h
+     * @brief 
+     *      A swerve module made of a drive MotorMotion, controlled by linear
+     *      velocity, and a steer MotorMotion, controlled by angular position.
+     * 
+     * The steer motor is put in continuous input mode, so the module never
+     * turns more than a quarter turn once the target state is optimized. The
+     * drive motor's wheel diameter and gearing give the wheel speed and
+     * distance; the steer motor's gearing gives the module angle. A TalonFX
+     * steer motor needs no wheel diameter, but a Spark Max one needs any 
+     * nonzero diameter, since its encoder counts meters.
+     * 
+     * Refresh() and the batched GetStates()/GetPositions() may run while a 
+     * MotorMotionScheduler refreshes the same motors; MotorMotion::Refresh() 
+     * serializes itself, so the two only take turns.
+     * @tparam ErrorEnum
+     *      The error type of the motor controllers
+     * @tparam MotorType
+     *      The motor controller type
+     */
+    template <typename ErrorEnum, class MotorType>
+    class SwerveModuleMotion {
+        public:
+            /**
+             * @brief 
+             *      Constructor that takes ownership of the drive and steer
+             *      motors of the module.
+             * @param drive
+             *      The MotorMotion object driving the wheel
+             * @param steer
+             *      The MotorMotion object turning the module
+             */
+            SwerveModuleMotion(
+                std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> /* drive */,
+                std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> /* steer */
+            );
+
+            /**
+             * @brief 
+             *      Drives the module towards a target state.
+             * 
+             * The target is first optimized against the current angle, so the
+             * wheel reverses rather than turning more than a quarter turn.
+             * The speed is then scaled by the cosine of the remaining angle
+             * error, so a wheel that isn't pointing the right way yet doesn't
+             * push the robot sideways.
+             * @param desired
+             *      The target speed and angle of the module
+             */
+            void SetDesiredState(const frc::SwerveModuleState& /* desired */);
+
+            /**
+             * @brief 
+             *      Stops both motors of the module.
+             */
+            void Stop();
+
+            /**
+             * @brief 
+             *      Refreshes the state of both motors of the module.
+             */
+            void Refresh();
+
+            /**
+             * @brief 
+             *      Returns the speed and angle of the module, read from the
+             *      cached state of its motors.
+             * @return 
+             *      The current state of the module
+             */
+            frc::SwerveModuleState GetState();
+
+            /**
+             * @brief 
+             *      Returns the distance and angle of the module, read from the
+             *      cached state of its motors.
+             * @return 
+             *      The current position of the module
+             */
+            frc::SwerveModulePosition GetPosition();
+
+            /**
+             * @brief 
+             *      Returns the drive motor of the module.
+             * @return 
+             *      MotorMotion object pointer of the drive motor
+             */
+            MotorMotion<ErrorEnum, MotorType>* GetDriveMotor();
+
+            /**
+             * @brief 
+             *      Returns the steer motor of the module.
+             * @return 
+             *      MotorMotion object pointer of the steer motor
+             */
+            MotorMotion<ErrorEnum, MotorType>* GetSteerMotor();
+
+            /**
+             * @brief 
+             *      Refreshes every module in one pass, then returns all of
+             *      their states.
+             * 
+             * Every motor is read back to back before any state is built, so
+             * the states form a single coherent sample. Each refresh waits for
+             * any refresh of the same motor already running, e.g. on a 
+             * MotorMotionScheduler thread.
+             * @param modules
+             *      The modules, in the order the kinematics expects them
+             * @return 
+             *      The state of each module, in the same order
+             */
+            template <size_t N>
+            static wpi::array<frc::SwerveModuleState, N> GetStates(const std::array<SwerveModuleMotion*, N>& modules) {
+                for (SwerveModuleMotion* module : modules) {
+                    module->Refresh();
+                }
+
+                wpi::array<frc::SwerveModuleState, N> states(wpi::empty_array);
+                for (size_t i = 0; i < N; i++) {
+                    states[i] = modules[i]->GetState();
+                }
+                return states;
+            }
+
+            /**
+             * @brief 
+             *      Refreshes every module in one pass, then returns all of
+             *      their positions, e.g. for odometry.
+             * 
+             * Every motor is read back to back before any position is built,
+             * so the positions form a single coherent sample. Each refresh 
+             * waits for any refresh of the same motor already running, e.g. 
+             * on a MotorMotionScheduler thread.
+             * @param modules
+             *      The modules, in the order the kinematics expects them
+             * @return 
+             *      The position of each module, in the same order
+             */
+            template <size_t N>
+            static wpi::array<frc::SwerveModulePosition, N> GetPositions(const std::array<SwerveModuleMotion*, N>& modules) {
+                for (SwerveModuleMotion* module : modules) {
+                    module->Refresh();
+                }
+
+                wpi::array<frc::SwerveModulePosition, N> positions(wpi::empty_array);
+                for (size_t i = 0; i < N; i++) {
+                    positions[i] = modules[i]->GetPosition();
+                }
+                return positions;
+            }
+
+        protected:
+            /** @brief The motor driving the wheel, controlled by linear velocity */
+            std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> drive;
+            /** @brief The motor turning the module, controlled by angular position */
+            std::unique_ptr<MotorMotion<ErrorEnum, MotorType>> steer;
+    }; // class SwerveModuleMotion
+
+    /** @brief A typedef of SwerveModuleMotion<...> specifically for TalonFXMotion */
+    typedef SwerveModuleMotion<ctre::phoenix::ErrorCode, ctre::phoenix::motorcontrol::can::WPI_TalonFX> TalonFXSwerveModule;
+    /** @brief A typedef of SwerveModuleMotion<...> specifically for SparkMaxMotion */
+    typedef SwerveModuleMotion<rev::REVLibError, rev::CANSparkMax> SparkMaxSwerveModule;
+
+} // namespace laser
@@ -30,9 +30,11 @@ with MotorMotion. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include <ctre/phoenix/motorcontrol/can/WPI_TalonFX.h>
+#include <ctre/phoenix/motion/BufferedTrajectoryPointStream.h>
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <frc/Timer.h>
 #include "laser/MotorMotion.h"
+#include "laser/StaticMotorMotion.h"
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace laser {
@@ -54,8 +56,8 @@ namespace talonfx {
      *      This namespace is meant to contain defaults and constants for the 
      *      TalonFXMotion class implementation.
      * 
-     * There's currently only one member of the namespace; however, future 
-     * releases may add more.
+     * This includes the sensor resolution of the Falcon 500 and the hardware 
+     * PID slots used by each setpoint type.
      */
     namespace defaults {
         /**
@@ -67,6 +69,101 @@ namespace talonfx {
          * used by default in the TalonFXMotion implementation.
          */
         constexpr double countsPerRev = 2048.0;
+
+        /**
+         * @brief 
+         *      The hardware PID slot holding the gains for position setpoints.
+         * 
+         * Each setpoint type has its own slot on the TalonFX, so switching 
+         * between them only needs a slot selection rather than rewriting the 
+         * gains.
+         */
+        constexpr int positionSlot = 0;
+
+        /**
+         * @brief 
+         *      The hardware PID slot holding the gains for linear velocity 
+         *      setpoints.
+         */
+        constexpr int linearVelocitySlot = 1;
+
+        /**
+         * @brief 
+         *      The hardware PID slot holding the gains for angular velocity 
+         *      setpoints.
+         */
+        constexpr int angularVelocitySlot = 2;
+
+        /**
+         * @brief 
+         *      The hardware PID slot holding the gains for profiled position 
+         *      (Motion Magic) setpoints.
+         */
+        constexpr int profiledPositionSlot = 3;
+
+        /**
+         * @brief 
+         *      The strongest S-curve smoothing the TalonFX supports for Motion 
+         *      Magic.
+         */
+        constexpr int maxSCurveStrength = 8;
+
+        /**
+         * @brief 
+         *      The number of trajectory points the TalonFX must have buffered 
+         *      before it starts executing a streamed trajectory.
+         */
+        constexpr int minBufferedPoints = 10;
+
+        /**
+         * @brief 
+         *      The longest duration a single trajectory point can hold on the 
+         *      TalonFX; longer points are split into several.
+         */
+        constexpr int maxPointDurationMs = 127;
+
+        /**
+         * @brief 
+         *      The period status frames are slowed down to when none of their
+         *      signals are consumed; the longest the TalonFX supports.
+         */
+        constexpr units::millisecond_t slowFramePeriod = 255.0_ms;
+
+        /**
+         * @brief 
+         *      A status frame of the TalonFX, its factory default period and
+         *      the signals it carries.
+         */
+        struct StatusFrameDefault {
+            /** @brief The status frame */
+            ctre::phoenix::motorcontrol::StatusFrameEnhanced frame;
+            /** @brief The factory default period of the frame */
+            units::millisecond_t period;
+            /** @brief Bitmask of the Signal values the frame carries */
+            int signals;
+        };
+
+        /**
+         * @brief 
+         *      Every status frame the TalonFX sends, with its approximate 
+         *      factory default period.
+         * 
+         * Frames carrying none of the signals MotorMotion reads are always 
+         * slowed down once SetConsumedSignals() is called.
+         */
+        constexpr StatusFrameDefault statusFrames[] = {
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_1_General, 10.0_ms, eSignalLimitSwitches | eSignalFaults | eSignalAppliedOutput },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_2_Feedback0, 20.0_ms, eSignalPosition | eSignalVelocity },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_Brushless_Current, 50.0_ms, eSignalCurrent },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_3_Quadrature, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_4_AinTempVbat, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_8_PulseWidth, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_10_Targets, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_12_Feedback1, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_13_Base_PIDF0, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_14_Turn_PIDF1, 160.0_ms, eSignalNone },
+            { ctre::phoenix::motorcontrol::StatusFrameEnhanced::Status_21_FeedbackIntegrated, 160.0_ms, eSignalNone }
+        };
     } // namespace defaults
 
     /**
@@ -79,9 +176,17 @@ namespace talonfx {
      * TalonFX/Falcon 500 motors. This makes them similar to control to Spark 
      * Max/NEO motors due to the common inheritance of the MotorMotion class, which 
      * can often be useful.
+     * 
+     * The getters are defined inline and served from the cached MotorState, 
+     * so code holding a TalonFXMotion through StaticMotorMotion gets them 
+     * inlined with no virtual dispatch.
      * @see MotorMotion
+     * @see StaticMotorMotion
      */
-    class TalonFXMotion : public MotorMotion<ctre::phoenix::ErrorCode, ctre::phoenix::motorcontrol::can::WPI_TalonFX> {
+    class TalonFXMotion : 
+        public MotorMotion<ctre::phoenix::ErrorCode, ctre::phoenix::motorcontrol::can::WPI_TalonFX>,
+        public StaticMotorMotion<TalonFXMotion> 
+    {
         public:
             /**
              * @brief 
@@ -110,7 +215,7 @@ namespace talonfx {
              * 
              * Generally this doesn't need to be directly called, it will be 
              * called in the destructor of the main class through the delete 
-             * call.
+             * call. Any queued async configuration writes are waited on first.
              */
             ~TalonFXMotion();
 
@@ -141,7 +246,9 @@ namespace talonfx {
              *      The amperage limit of the motor in units::ampere_t
              * @return 
              *      The error reported by the motor controller, based on the 
-             *      derived class's inheritance template
+             *      derived class's inheritance template; in async 
+             *      configuration mode this is reported through GetLastError()
+             *      instead
              */
             ctre::phoenix::ErrorCode ConfigCurrentLimit(units::ampere_t /* amps */) override;
 
@@ -164,7 +271,7 @@ namespace talonfx {
              * @return 
              *      units::meter_t representing the distance traveled in meters
              */
-            units::meter_t GetActualPosition() override;
+            units::meter_t GetActualPosition() override { return Snapshot().position; }
 
             /**
              * @brief 
@@ -175,7 +282,7 @@ namespace talonfx {
              * @return 
              *      units::meters_per_second_t representing the velocity in m/s
              */
-            units::meters_per_second_t GetActualVelocity() override;
+            units::meters_per_second_t GetActualVelocity() override { return Snapshot().velocity; }
 
             /**
              * @brief 
@@ -188,7 +295,7 @@ namespace talonfx {
              *      units::radians_per_second_t representing the angular 
              *      velocity in rad/s
              */
-            units::radians_per_second_t GetActualAngularVelocity() override;
+            units::radians_per_second_t GetActualAngularVelocity() override { return Snapshot().angularVelocity; }
 
             /**
              * @brief 
@@ -227,6 +334,15 @@ namespace talonfx {
              */
             units::radians_per_second_t GetAngularVelocityTolerance() override;
 
+            /**
+             * @brief 
+             *      Returns the tolerance of the angular position in radians.
+             * @return 
+             *      The max tolerance of the angle; how far off the actual is 
+             *      liable to be from the setpoint
+             */
+            units::radian_t GetAngularPositionTolerance() override;
+
             /**
              * @brief 
              *      Sets whether the motor is to spin opposite of the default
@@ -245,9 +361,9 @@ namespace talonfx {
              *      Sets the PIDF values for the controller.
              * 
              * Each setpoint type has its own PID values, this method will feed 
-             * it to the currently active one (default/none: no PIDF values are 
-             * saved). PIDF is used for closed loop control of reaching a 
-             * setpoint.
+             * it to the currently active one (default/none: every setpoint type
+             * gets the same PIDF values). PIDF is used for closed loop control 
+             * of reaching a setpoint.
              * @param proportional
              *      The desired proportional gain
              * @param integral
@@ -265,6 +381,34 @@ namespace talonfx {
                 double /* feedforward */
             ) override;
 
+            /**
+             * @brief 
+             *      Sets the PIDF values for a specific setpoint type.
+             * 
+             * Each setpoint type is stored in its own hardware slot on the 
+             * TalonFX (see the defaults namespace), so all of them can be 
+             * configured up front and SetSetpoint() only has to select the 
+             * slot when the setpoint type changes.
+             * @param type
+             *      The setpoint type whose PID values should be set; eNone is
+             *      ignored
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            void SetPIDValues(
+                SetpointType /* type */,
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            ) override;
+
             /**
              * @brief 
              *      Sets the maximum tolerance for the position setpoint.
@@ -302,6 +446,20 @@ namespace talonfx {
              */
             void SetTolerance(units::radians_per_second_t /* tolerance */) override;
 
+            /**
+             * @brief 
+             *      Sets the maximum tolerance for the angular position 
+             *      setpoint.
+             * 
+             * Angular position setpoints share the position slot, so the 
+             * allowable error configured on the controller is the one set for
+             * positions in meters; this tolerance is only used to decide 
+             * whether the setpoint has been reached.
+             * @param tolerance
+             *      The maximum tolerance in units::radian_t
+             */
+            void SetTolerance(units::radian_t /* tolerance */) override;
+
             /**
              * @brief 
              *      Returns the motor voltage.
@@ -311,7 +469,7 @@ namespace talonfx {
              * @return 
              *      units::volt_t representing the motor voltage in Volts
              */
-            units::volt_t GetMotorVoltage() override;
+            units::volt_t GetMotorVoltage() override { return Snapshot().voltage; }
 
             /**
              * @brief 
@@ -333,7 +491,7 @@ namespace talonfx {
              * @return
              *      units::ampere_t representing the motor amperage in Amperes
              */
-            units::ampere_t GetMotorCurrent() override;
+            units::ampere_t GetMotorCurrent() override { return Snapshot().current; }
 
             /**
              * @brief 
@@ -349,7 +507,7 @@ namespace talonfx {
              * @see GetActualVelocity()
              * @see GetActualAngularVelocity()
              */
-            int GetRawEncoderCounts() override;
+            int GetRawEncoderCounts() override { return Snapshot().rawEncoderCounts; }
 
             /**
              * @brief 
@@ -423,6 +581,98 @@ namespace talonfx {
              */
             void SetSetpoint(units::radians_per_second_t /* avelocity */) override;
 
+            /**
+             * @brief 
+             *      Sets the setpoint for the angle of the output shaft in 
+             *      radians.
+             * 
+             * The angle is converted to integrated sensor counts through the 
+             * gearing alone, so the wheel diameter plays no part, and reached
+             * through the position slot, with the same gains as positions in
+             * meters. With continuous input, the shortest rotation to an 
+             * equivalent angle is taken, so a swerve module never turns more
+             * than half a turn.
+             * @param angle
+             *      Desired angle of the output shaft in units::radian_t
+             * @see SetContinuousInput()
+             */
+            void SetSetpoint(units::radian_t /* angle */) override;
+
+            /**
+             * @brief 
+             *      Sets the Motion Magic constraints used by profiled position
+             *      setpoints.
+             * 
+             * These are converted to encoder counts per 100ms (and per 100ms 
+             * per second) and configured on the TalonFX, which generates the 
+             * profile itself at 1 kHz; nothing is computed on the roboRIO.
+             * @param maxVelocity
+             *      The cruise velocity of the profile in 
+             *      units::meters_per_second_t
+             * @param maxAcceleration
+             *      The acceleration of the profile in 
+             *      units::meters_per_second_squared_t
+             * @param sCurveStrength
+             *      How much the acceleration is smoothed, from 0 (trapezoidal)
+             *      to 8 (smoothest); values outside of this are clamped
+             */
+            void SetMotionConstraints(
+                units::meters_per_second_t /* maxVelocity */, 
+                units::meters_per_second_squared_t /* maxAcceleration */, 
+                int /* sCurveStrength */
+            ) override;
+
+            /**
+             * @brief 
+             *      Sets a position setpoint in meters that is reached through 
+             *      Motion Magic.
+             * 
+             * Unlike SetSetpoint(units::meter_t), which steps the position 
+             * loop straight to the target, this follows a profile limited by 
+             * SetMotionConstraints(), so mechanisms move quickly without 
+             * overshooting. The gains come from the profiled position slot.
+             * @param position
+             *      Desired position of the motor in units::meter_t
+             * @see SetMotionConstraints()
+             */
+            void SetProfiledSetpoint(units::meter_t /* position */) override;
+
+            /**
+             * @brief 
+             *      Streams a trajectory into the TalonFX's motion profile 
+             *      buffer and starts executing it.
+             * 
+             * The points are converted to encoder counts and written into a 
+             * buffered point stream, which the Phoenix library feeds to the 
+             * controller in the background. The controller executes each 
+             * point for the time until the next one, so roboRIO loop jitter 
+             * has no effect on tracking. The first point is held from the 
+             * start of the trajectory, durations are rounded to the nearest 
+             * millisecond and points held longer than 127 ms are split. The 
+             * gains come from the profiled position slot. Starting a new 
+             * trajectory stops the previous one.
+             * @param points
+             *      The timed points of the trajectory, in strictly increasing 
+             *      order of time
+             * @return 
+             *      ErrorCode::InvalidParamValue when the trajectory is empty or 
+             *      out of order; otherwise the error reported by the motor 
+             *      controller
+             * @see GetTrajectoryProgress()
+             */
+            ctre::phoenix::ErrorCode StartTrajectory(std::span<const TrajectoryPoint> /* points */) override;
+
+            /**
+             * @brief 
+             *      Returns the progress of the streamed trajectory.
+             * 
+             * This reads the motion profile status of the TalonFX, so check 
+             * it at most once per loop.
+             * @return 
+             *      The buffer, underrun and completion state of the trajectory
+             */
+            TrajectoryProgress GetTrajectoryProgress() override;
+
             /**
              * @brief 
              *      Sets the Integral Zone for error in units per millisecond.
@@ -444,21 +694,31 @@ namespace talonfx {
              *      not intentionally leave the interval of values, [minpos, 
              *      maxpos].
              * 
-             * This is meant to be used for setpoint checking.
-             * @warning 
-             *      This method is not currently implemented, do not use it 
-             *      until a further release.
+             * The limits become the forward and reverse soft limit thresholds
+             * of the TalonFX, in integrated sensor counts, so it stops driving
+             * past them within its own 1 ms control cycle. They are re-applied
+             * whenever the gearing or wheel diameter changes; passing equal 
+             * values disables them, and limits given in the wrong order are 
+             * swapped.
              * @param minpos
-             *      Minimum position value in units::meter_t, must be less
-             *      than maxpos
+             *      Minimum position value in units::meter_t
              * @param maxpos
-             *      Maximum position values in units::meter_t, must be greater
-             *      than minpos
-             * @todo 
-             *      Implement.
+             *      Maximum position values in units::meter_t
              */
             void SetPositionSoftLimits(units::meter_t /* minpos */, units::meter_t /* maxpos */) override;
 
+            /**
+             * @brief 
+             *      Makes the TalonFX zero its integrated sensor as soon as the
+             *      reverse limit switch closes, within its own control cycle.
+             * @param isEnabled
+             *      When true, closing the reverse limit switch clears the 
+             *      position
+             * @return 
+             *      The error reported by the motor controller
+             */
+            ctre::phoenix::ErrorCode SetClearPositionOnRevLimit(bool /* isEnabled */) override;
+
             /**
              * @brief 
              *      Returns the state of the reverse limit switch.
@@ -469,7 +729,7 @@ namespace talonfx {
              *      Boolean value, true = pressed, false = unpressed
              * @see MotorMotionCommand.h
              */
-            bool IsRevLimitSwitchPressed() override;
+            bool IsRevLimitSwitchPressed() override { return Snapshot().isRevLimitSwitchPressed; }
 
             /**
              * @brief 
@@ -481,16 +741,177 @@ namespace talonfx {
              *      Boolean value, true = pressed, false = unpressed
              * @see MotorMotionCommand.h
              */
-            bool IsFwdLimitSwitchPressed() override;
+            bool IsFwdLimitSwitchPressed() override { return Snapshot().isFwdLimitSwitchPressed; }
 
             /**
              * @brief 
              *      Stops the motor and resets the encoder to 0.
              * 
              * This is useful when powering on the robot and initializing 
-             * subsystems.
+             * subsystems. When an absolute sensor is attached, the encoder is
+             * seeded with the true mechanism position instead.
+             * @see SetAbsoluteSensor()
              */
             void Reset() override;
+
+            /**
+             * @brief 
+             *      Reads every signal from the TalonFX once and stores it in 
+             *      the cached MotorState.
+             * 
+             * Call this once per loop (or leave it to the getters, which call 
+             * it whenever the cached state is older than the max state age). 
+             * All of the getters on this class are served from the snapshot, 
+             * so vendor calls scale with the number of motors rather than the 
+             * number of readers.
+             * @see GetState()
+             * @see SetStateMaxAge()
+             */
+            void Refresh() override;
+
+            /**
+             * @brief 
+             *      Steps the attached mechanism and feeds the result into the 
+             *      TalonFX's simulation collection.
+             * 
+             * The lead voltage of the simulated TalonFX drives the mechanism;
+             * its output shaft angle and velocity are converted to integrated
+             * sensor counts, and its current draw becomes the stator current.
+             * The supply current is estimated from the duty cycle and the 
+             * bus voltage is taken from the simulated battery. Call this from
+             * SimulationPeriodic() with the robot's loop period.
+             * @param dt
+             *      The length of the time step in units::second_t
+             * @see AttachSimulation()
+             */
+            void SimulationPeriodic(units::second_t /* dt */) override;
+
+            /**
+             * @brief 
+             *      Makes this TalonFX follow another one.
+             * 
+             * The inversion is relative to the leader through 
+             * InvertType::FollowMaster or InvertType::OpposeMaster, so it 
+             * stays correct if the leader is inverted later.
+             * @param leader
+             *      The TalonFXMotion object to follow
+             * @param isOpposed
+             *      When true, the output is reversed relative to the leader
+             * @return 
+             *      The error reported by the motor controller
+             */
+            ctre::phoenix::ErrorCode Follow(MotorMotion& /* leader */, bool /* isOpposed */) override;
+
+            /**
+             * @brief 
+             *      Sets how often the TalonFX sends a status frame.
+             * @param frame
+             *      The status frame to configure
+             * @param period
+             *      The period of the frame in units::millisecond_t, from 1 to 
+             *      255 ms
+             * @return 
+             *      The error reported by the motor controller; in async 
+             *      configuration mode this is reported through GetLastError()
+             *      instead
+             */
+            ctre::phoenix::ErrorCode SetStatusFramePeriod(ctre::phoenix::motorcontrol::StatusFrameEnhanced /* frame */, units::millisecond_t /* period */);
+
+        protected:
+            /**
+             * @brief 
+             *      Runs the status frames carrying the consumed signals at 
+             *      their default rates and slows every other one down.
+             * 
+             * The limit switches and faults share the general status frame, 
+             * and position and velocity share the primary feedback frame.
+             * @param signals
+             *      A bitmask of Signal values
+             * @return 
+             *      The first error reported while setting the frame periods
+             * @see defaults::statusFrames
+             */
+            ctre::phoenix::ErrorCode ApplySignalFrames(int /* signals */) override;
+
+            /**
+             * @brief 
+             *      Reads every signal Refresh() publishes from the TalonFX; 
+             *      called while holding the refresh mutex.
+             * @return 
+             *      The measured state, without setpoints
+             */
+            MotorState ReadSensors();
+
+            /**
+             * @brief 
+             *      Recomputes the conversion factors between meters, m/s, 
+             *      rad/s and the TalonFX's encoder counts.
+             * 
+             * This is called by the constructor, SetGearing() and 
+             * SetWheelDiameter(), so the setpoints and getters only need one 
+             * multiplication per conversion. The tolerances and integral zone 
+             * are stored on the controller in encoder counts, so they are 
+             * re-applied with the new factors.
+             */
+            void UpdateConversionFactors() override;
+
+            /**
+             * @brief 
+             *      Computes the arbitrary feedforward demand sent with a 
+             *      setpoint.
+             * 
+             * The TalonFX takes the arbitrary feedforward as a fraction of 
+             * its output, so the voltage from the feedforward model is divided
+             * by the battery voltage.
+             * @param position
+             *      The position the feedforward is evaluated at: the target 
+             *      of a position setpoint, or the measured position
+             * @param velocity
+             *      The velocity the setpoint asks for (zero for positions)
+             * @return 
+             *      The feedforward as a fraction of the bus voltage, or zero 
+             *      when no model is set
+             */
+            double GetFeedforwardPercent(units::meter_t /* position */, units::meters_per_second_t /* velocity */);
+
+            /**
+             * @brief 
+             *      Writes PIDF gains into a hardware slot through the shadow 
+             *      configuration cache.
+             * 
+             * Only the gains that differ from the last ones written to the 
+             * slot reach the CAN bus.
+             * @param slot
+             *      The hardware PID slot to write
+             * @param proportional
+             *      The desired proportional gain
+             * @param integral
+             *      The desired integral gain
+             * @param derivative
+             *      The desired derivative gain
+             * @param feedforward
+             *      The desired feed forward gain
+             */
+            void ConfigSlot(
+                int /* slot */,
+                double /* proportional */, 
+                double /* integral */, 
+                double /* derivative */, 
+                double /* feedforward */
+            );
+
+            /**
+             * @brief 
+             *      The point stream the Phoenix library feeds into the 
+             *      TalonFX's motion profile buffer.
+             */
+            ctre::phoenix::motion::BufferedTrajectoryPointStream* trajectoryStream;
+
+            /**
+             * @brief 
+             *      Number of points in the trajectory last started.
+             */
+            int trajectoryPoints = 0;
     }; // class TalonFXMotion
 
 } // namespace talonfx
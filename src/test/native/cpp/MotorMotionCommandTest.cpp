@@ -0,0 +1,60 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MotorMotionCommandTest.cpp
+ * @brief 
+ *      Tests of the MotorMotionCommand homing routines, run on plant driven
+ *      mechanisms.
+ */
+
+#include <frc/system/plant/DCMotor.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include "laser/MotorMotionCommand.h"
+#include "laser/SimulationHarness.h"
+#include "laser/TalonFXMotion.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(MotorMotionCommandTest, StallHomingZeroesAtHardStop) {
+    simulation::SimulationHarness harness;
+
+    // The hard stop is 0.3 m below where the carriage starts
+    talonfx::TalonFXMotion motion(4, 10.0, 0.1_m);
+    motion.AttachSimulation(std::make_unique<simulation::ElevatorMechanism>(
+        frc::DCMotor::Falcon500(), 10.0, 5.0_kg, 0.05_m, -0.3_m, 1.0_m, false
+    ));
+    harness.AddMotor(&motion);
+
+    commands::TalonFXMotionCommand home(&motion, commands::eHomeReverseStall, 5.0_s, -0.3);
+    home.SetStallDetection(20.0_A, 0.02_mps);
+    harness.Schedule(&home);
+
+    // Well before the timeout, which would end homing without a stall
+    ASSERT_TRUE(harness.RunUntil([&] { return !harness.IsScheduled(&home); }, 2.0_s));
+
+    EXPECT_TRUE(motion.GetSimulation()->IsAtLowerLimit());
+    EXPECT_TRUE(motion.IsStopped());
+    EXPECT_NEAR((double)motion.GetActualPosition(), 0.0, 1e-9);
+
+    // Stopped at the new zero
+    harness.Run(0.1_s);
+    EXPECT_NEAR((double)motion.GetActualPosition(), 0.0, 1e-9);
+}
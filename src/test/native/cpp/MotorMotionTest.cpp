@@ -0,0 +1,83 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file MotorMotionTest.cpp
+ * @brief 
+ *      Tests of the MotorMotion base class, through a plant driven 
+ *      TalonFXMotion.
+ */
+
+#include <frc/system/plant/DCMotor.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include "laser/TalonFXMotion.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+    /**
+     * @brief 
+     *      An absolute reading, and where the mechanism should be seeded 
+     *      from it
+     */
+    struct SeedCase {
+        std::optional<units::turn_t> reading;
+        double ratio;
+        units::turn_t offset;
+        bool isValid;
+        double expectedTurns;
+    };
+
+} // namespace
+
+TEST(MotorMotionTest, AbsoluteSeedWrapsAroundZero) {
+    talonfx::TalonFXMotion motion(3, 10.0, 0.1_m);
+    motion.AttachSimulation(std::make_unique<simulation::FlywheelMechanism>(
+        frc::DCMotor::Falcon500(), 10.0, units::kilogram_square_meter_t(0.01)
+    ));
+    motion.SetPlantDriven(true);
+
+    const SeedCase cases[] = {
+        { 0.25_tr, 1.0, 0.0_tr, true, 0.25 },
+        { 0.7_tr, 1.0, 0.0_tr, true, -0.3 },
+        { 1.45_tr, 1.0, 0.0_tr, true, 0.45 },
+        // Half a turn either way lands on the lower end of [-0.5, 0.5)
+        { 0.5_tr, 1.0, 0.0_tr, true, -0.5 },
+        { -0.5_tr, 1.0, 0.0_tr, true, -0.5 },
+        { 0.1_tr, 1.0, 0.5_tr, true, -0.4 },
+        { 0.9_tr, 0.5, 0.0_tr, true, -0.05 },
+        { std::nullopt, 1.0, 0.0_tr, false, 0.0 }
+    };
+
+    for (const SeedCase& seed : cases) {
+        SCOPED_TRACE(seed.reading ? (double)*seed.reading : NAN);
+
+        std::optional<units::turn_t> reading = seed.reading;
+        EXPECT_EQ(motion.SetAbsoluteSensor([reading] { return reading; }, seed.ratio, seed.offset), seed.isValid);
+        EXPECT_EQ(motion.IsAbsoluteSeedValid(), seed.isValid);
+
+        // output shaft turns -> meters
+        motion.Refresh();
+        EXPECT_NEAR((double)motion.GetActualPosition(), seed.expectedTurns * 0.1 * M_PI, 1e-9);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file SimulationHarnessTest.cpp
+ * @brief 
+ *      Tests of the SimulationHarness stepping plant driven mechanisms.
+ */
+
+#include <frc/controller/PIDController.h>
+#include <frc/system/plant/DCMotor.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "laser/SimulationHarness.h"
+#include "laser/TalonFXMotion.h"
+
+using namespace laser;
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+    /**
+     * @brief 
+     *      Raises an elevator to 1 m with a roboRIO-side PID loop and records
+     *      the state after every step
+     */
+    std::vector<MotorState> RunElevator() {
+        simulation::SimulationHarness harness;
+
+        talonfx::TalonFXMotion motion(1, 10.0, 0.1_m);
+        motion.AttachSimulation(std::make_unique<simulation::ElevatorMechanism>(
+            frc::DCMotor::Falcon500(), 10.0, 5.0_kg, 0.05_m, 0.0_m, 1.5_m, true
+        ));
+        harness.AddMotor(&motion);
+
+        frc2::PIDController pid(40.0, 0.0, 1.0, harness.GetStep());
+        harness.AddControlLoop([&] {
+            motion.SetMotorVoltage(units::volt_t(pid.Calculate((double)motion.GetActualPosition(), 1.0)));
+        });
+
+        std::vector<MotorState> states;
+        for (int i = 0; i < 400; i++) {
+            harness.Step();
+            states.push_back(motion.GetState());
+        }
+        return states;
+    }
+
+} // namespace
+
+TEST(SimulationHarnessTest, IdenticalRunsMatch) {
+    std::vector<MotorState> first = RunElevator();
+    std::vector<MotorState> second = RunElevator();
+
+    // The run has to actually go somewhere to mean anything
+    ASSERT_NEAR((double)first.back().position, 1.0, 0.05);
+
+    // Timestamps continue from the previous run, so only the measurements 
+    // are compared, and they must match exactly
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        SCOPED_TRACE(i);
+        EXPECT_EQ((double)first[i].position, (double)second[i].position);
+        EXPECT_EQ((double)first[i].velocity, (double)second[i].velocity);
+        EXPECT_EQ((double)first[i].angularPosition, (double)second[i].angularPosition);
+        EXPECT_EQ((double)first[i].current, (double)second[i].current);
+        EXPECT_EQ((double)first[i].voltage, (double)second[i].voltage);
+        EXPECT_EQ(first[i].rawEncoderCounts, second[i].rawEncoderCounts);
+        EXPECT_EQ(first[i].isFwdLimitSwitchPressed, second[i].isFwdLimitSwitchPressed);
+        EXPECT_EQ(first[i].isRevLimitSwitchPressed, second[i].isRevLimitSwitchPressed);
+    }
+}
+
+TEST(SimulationHarnessTest, LimitSwitchEventsFireOnEdges) {
+    simulation::SimulationHarness harness;
+
+    // The carriage starts at the bottom, on the reverse limit
+    talonfx::TalonFXMotion motion(2, 10.0, 0.1_m);
+    motion.AttachSimulation(std::make_unique<simulation::ElevatorMechanism>(
+        frc::DCMotor::Falcon500(), 10.0, 5.0_kg, 0.05_m, 0.0_m, 0.5_m, false
+    ));
+    harness.AddMotor(&motion);
+
+    int fwdPressed = 0, fwdReleased = 0, revPressed = 0, revReleased = 0;
+    motion.AddListener(eFwdLimitSwitchPressed, [&] { fwdPressed++; });
+    motion.AddListener(eFwdLimitSwitchReleased, [&] { fwdReleased++; });
+    motion.AddListener(eRevLimitSwitchPressed, [&] { revPressed++; });
+    motion.AddListener(eRevLimitSwitchReleased, [&] { revReleased++; });
+
+    // The first refresh only sets the baseline, with the carriage still down
+    harness.Step();
+    ASSERT_TRUE(motion.IsRevLimitSwitchPressed());
+
+    motion.Set(0.3);
+    ASSERT_TRUE(harness.RunUntil([&] { return motion.IsFwdLimitSwitchPressed(); }, 2.0_s));
+    EXPECT_EQ(revReleased, 1);
+    EXPECT_EQ(fwdPressed, 1);
+
+    // Holding a switch doesn't fire it again
+    harness.Run(0.5_s);
+    EXPECT_EQ(fwdPressed, 1);
+    EXPECT_EQ(fwdReleased, 0);
+
+    motion.Set(-0.3);
+    ASSERT_TRUE(harness.RunUntil([&] { return motion.IsRevLimitSwitchPressed(); }, 2.0_s));
+    EXPECT_EQ(fwdReleased, 1);
+    EXPECT_EQ(revPressed, 1);
+
+    EXPECT_EQ(fwdPressed, 1);
+    EXPECT_EQ(revReleased, 1);
+}
@@ -0,0 +1,37 @@
+/*
+Copyright 2022 Camdenton LASER 3284
+
+This file is part of MotorMotion.
+
+MotorMotion is free software: you can redistribute it and/or modify it under 
+the terms of the GNU Lesser General Public License as published by the Free 
+Software Foundation, either version 3 of the License, or (at your option) any 
+later version.
+
+MotorMotion is distributed in the hope that it will be useful, but WITHOUT ANY 
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A 
+PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along 
+with MotorMotion. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file main.cpp
+ * @brief 
+ *      Entry point of the MotorMotion unit tests, run against the simulation
+ *      HAL.
+ */
+
+#include <hal/HALBase.h>
+#include <gtest/gtest.h>
+////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+    if (!HAL_Initialize(500, 0)) {
+        return 1;
+    }
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}